@@ -0,0 +1,98 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file checksum.h
+/// @brief Checksums, and fused copy-and-checksum functions which load every
+/// byte only once.
+///
+/// - Internet checksum (RFC 1071) is accumulated as 32-bit partial sum in
+/// native byte order, chunks can be chained if all but the last one have even
+/// length. Use csum_fold() to get the final 16-bit checksum.
+///
+/// - CRC-32 (IEEE 802.3) and CRC-32C (Castagnoli) follow the zlib convention:
+/// start with `crc` = 0 and pass the result of the previous chunk to continue.
+
+#ifndef NOC_CHECKSUM_H
+#define NOC_CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Compute Internet checksum partial sum.
+///
+/// @param buf data to checksum
+/// @param len length of data in bytes
+/// @param sum partial sum of preceding data, 0 to start
+/// @return partial sum to pass to csum_fold() or the next call
+uint32_t csum_partial(const void *buf, size_t len, uint32_t sum);
+
+/// @brief Copy memory and compute Internet checksum partial sum of it.
+///
+/// @param dest address of destination
+/// @param src address of source object
+/// @param len length in bytes
+/// @param sum partial sum of preceding data, 0 to start
+/// @return partial sum to pass to csum_fold() or the next call
+uint32_t memcpy_csum(void *restrict dest, const void *restrict src, size_t len,
+                     uint32_t sum);
+
+/// @brief Fold partial sum into 16-bit Internet checksum.
+///
+/// @param sum partial sum from csum_partial() or memcpy_csum()
+/// @return ones' complement of the 16-bit sum, in native byte order, ready to
+/// be stored into a header. Checksum of data including a valid checksum is 0.
+static inline uint16_t csum_fold(uint32_t sum) {
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+/// @brief Compute CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320).
+///
+/// @param crc CRC of preceding data, 0 to start
+/// @param buf data to checksum
+/// @param len length of data in bytes
+/// @return CRC of data
+uint32_t crc32(uint32_t crc, const void *buf, size_t len);
+
+/// @brief Copy memory and compute CRC-32 of it.
+///
+/// @param dest address of destination
+/// @param src address of source object
+/// @param len length in bytes
+/// @param crc CRC of preceding data, 0 to start
+/// @return CRC of data
+uint32_t memcpy_crc32(void *restrict dest, const void *restrict src,
+                      size_t len, uint32_t crc);
+
+/// @brief Compute CRC-32C (Castagnoli, reflected polynomial 0x82F63B78).
+///
+/// Uses the SSE4.2 crc32 instruction when available.
+/// @param crc CRC of preceding data, 0 to start
+/// @param buf data to checksum
+/// @param len length of data in bytes
+/// @return CRC of data
+uint32_t crc32c(uint32_t crc, const void *buf, size_t len);
+
+/// @brief Copy memory and compute CRC-32C of it.
+///
+/// @param dest address of destination
+/// @param src address of source object
+/// @param len length in bytes
+/// @param crc CRC of preceding data, 0 to start
+/// @return CRC of data
+uint32_t memcpy_crc32c(void *restrict dest, const void *restrict src,
+                       size_t len, uint32_t crc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_CHECKSUM_H */
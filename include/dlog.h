@@ -0,0 +1,126 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file dlog.h
+/// @brief Deferred binary logging.
+///
+/// dlog() records the address of the format string and raw argument values
+/// into a ring buffer, leaving text rendering for later: dlog_flush() prints
+/// pending records on the device when time allows, or dlog_read() moves the
+/// binary records out to be rendered on a host with dlog_snprintf(), looking
+/// up format strings by address in the firmware image.
+///
+/// Strings and %H data are copied into the record, as the pointers may not be
+/// valid when the record is rendered. Strings are limited to DLOG_MAX_STRING
+/// characters. The host renderer must have the same size of pointers, long
+/// and size_t as the device, which define argument sizes.
+///
+/// dlog() is called from a single context at a time, records are read by
+/// another one.
+
+#ifndef NOC_DLOG_H
+#define NOC_DLOG_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Size of ring buffer in bytes, power of 2
+#ifndef DLOG_BUFFER_SIZE
+#define DLOG_BUFFER_SIZE 1024
+#endif
+
+/// Maximum size of one record in bytes, multiple of 4
+#ifndef DLOG_MAX_RECORD
+#define DLOG_MAX_RECORD 128
+#endif
+
+/// Maximum length of a string argument stored in a record
+#ifndef DLOG_MAX_STRING
+#define DLOG_MAX_STRING 32
+#endif
+
+/// @brief Record decoded by dlog_next().
+struct dlog_record {
+    uint64_t format;   ///< Address of format string on the device
+    const void *args;  ///< Encoded arguments
+    size_t args_len;   ///< Length of encoded arguments in bytes
+};
+
+/// @brief Log formatted message for later rendering.
+///
+/// Format string must remain valid, usually a string literal.
+/// @param format format string, as for printf()
+/// @param ... arguments
+/// @return 0 on success, EOF if buffer is full or format is not supported
+int dlog(const char *format, ...)
+    __attribute__((__format__(__printf__, 1, 2)));
+
+/// @brief Encode record of format and arguments, as stored by dlog().
+///
+/// @param dest destination
+/// @param size size of destination, DLOG_MAX_RECORD is enough for any record
+/// accepted by dlog()
+/// @param format format string
+/// @param args arguments
+/// @return size of record in bytes, multiple of 4, or -1 if format is not
+/// supported or record doesn't fit
+intptr_t dlog_encode(void *dest, size_t size, const char *format,
+                     va_list args);
+
+/// @brief Move complete records out of the ring buffer.
+///
+/// @param dest destination
+/// @param len size of destination, DLOG_MAX_RECORD is enough for any record
+/// @return number of bytes written
+size_t dlog_read(void *dest, size_t len);
+
+/// @brief Number of records dropped as the ring buffer was full, reset on
+/// read.
+uint32_t dlog_dropped(void);
+
+/// @brief Decode next record from data returned by dlog_read().
+///
+/// @param data records
+/// @param len length of data in bytes
+/// @param rec decoded record, points into `data`
+/// @return size of record to skip to the next one, 0 if no valid record
+size_t dlog_next(const void *data, size_t len, struct dlog_record *rec);
+
+/// @brief Render record to string, see snprintf().
+///
+/// @param s destination string buffer
+/// @param n size of destination buffer
+/// @param format format string of the record
+/// @param rec record
+/// @return the number of characters that would have been written had n been
+/// sufficiently large, not counting the terminating null character
+int dlog_snprintf(char *restrict s, size_t n, const char *format,
+                  const struct dlog_record *rec);
+
+/// @brief Render record on standard output, see printf().
+///
+/// @param format format string of the record
+/// @param rec record
+/// @return number of characters written
+int dlog_printf(const char *format, const struct dlog_record *rec);
+
+/// @brief Render all pending records on standard output.
+///
+/// Format strings are taken from addresses in records. Number of dropped
+/// records is reported, if any.
+/// @return number of characters written, or EOF on error
+int dlog_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_DLOG_H */
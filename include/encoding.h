@@ -0,0 +1,67 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file encoding.h
+/// @brief Bulk binary to text encoding: hexadecimal and base64 (RFC 4648).
+///
+/// Encoders don't add the null character. Decoders reject invalid input, in
+/// which case contents of the destination are unspecified.
+
+#ifndef NOC_ENCODING_H
+#define NOC_ENCODING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Length of base64 encoding of `n` bytes, including padding
+#define BASE64_ENCODED_LEN(n) ((((n) + 2) / 3) * 4)
+
+/// Maximum length of data decoded from `n` base64 characters
+#define BASE64_DECODED_LEN(n) (((n) / 4) * 3 + ((n) % 4) * 3 / 4)
+
+/// @brief Encode data as lowercase hexadecimal digits.
+///
+/// @param dest destination, 2 * `len` characters
+/// @param src data to encode
+/// @param len length of data in bytes
+/// @return number of characters written, 2 * `len`
+size_t hex_encode(char *restrict dest, const void *restrict src, size_t len);
+
+/// @brief Decode hexadecimal digits, both cases accepted.
+///
+/// @param dest destination, `len` / 2 bytes
+/// @param src digits to decode
+/// @param len number of digits, must be even
+/// @return number of bytes written, or -1 if input is invalid
+intptr_t hex_decode(void *restrict dest, const char *restrict src, size_t len);
+
+/// @brief Encode data in base64 with padding.
+///
+/// @param dest destination, BASE64_ENCODED_LEN(`len`) characters
+/// @param src data to encode
+/// @param len length of data in bytes
+/// @return number of characters written
+size_t base64_encode(char *restrict dest, const void *restrict src,
+                     size_t len);
+
+/// @brief Decode base64, padding is optional.
+///
+/// @param dest destination, BASE64_DECODED_LEN(`len`) bytes
+/// @param src characters to decode
+/// @param len number of characters
+/// @return number of bytes written, or -1 if input is invalid
+intptr_t base64_decode(void *restrict dest, const char *restrict src,
+                       size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_ENCODING_H */
@@ -0,0 +1,95 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file logring.h
+/// @brief Lock-free multi-producer log ring buffer.
+///
+/// Threads and interrupt handlers format messages into slots reserved in a
+/// shared ring buffer, without locks and without waiting for console output.
+/// A single consumer pushes completed records to putnstr() in large batches
+/// with logring_drain(), or takes them with logring_read().
+///
+/// Records are output in the order of reservation. A reserved record which
+/// is not committed yet holds back later ones. When the ring is full, new
+/// records are dropped and counted.
+
+#ifndef NOC_LOGRING_H
+#define NOC_LOGRING_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Size of ring buffer in bytes, power of 2, at most 128 KiB
+#ifndef LOGRING_SIZE
+#define LOGRING_SIZE 4096
+#endif
+
+/// Maximum size of one record in bytes including 4 bytes header, multiple of
+/// 4. Longer messages are truncated.
+#ifndef LOGRING_MAX_RECORD
+#define LOGRING_MAX_RECORD 256
+#endif
+
+/// Size of buffer used by logring_drain() on stack
+#ifndef LOGRING_BATCH
+#define LOGRING_BATCH 512
+#endif
+
+/// @brief Reserve space for a record of up to `len` bytes of text.
+///
+/// Only first bytes committed with logring_commit() may be written, the rest
+/// of reserved space is returned if possible.
+/// @param len length of text, at most LOGRING_MAX_RECORD - 4
+/// @param ticket ticket to pass to logring_commit()
+/// @return space for text, or NULL if ring is full
+char *logring_reserve(size_t len, uint32_t *ticket);
+
+/// @brief Commit record, making it available to the consumer.
+///
+/// @param ticket ticket returned by logring_reserve()
+/// @param len length of text written, at most as reserved
+void logring_commit(uint32_t ticket, size_t len);
+
+/// @brief Format message into the ring, see printf().
+///
+/// @param format format string
+/// @param ... arguments
+/// @return number of characters logged, EOF if ring is full or on error
+int logring_printf(const char *format, ...)
+    __attribute__((__format__(__printf__, 1, 2)));
+
+/// @brief Format message into the ring, see vprintf().
+///
+/// @param format format string
+/// @param args arguments
+/// @return number of characters logged, EOF if ring is full or on error
+int logring_vprintf(const char *format, va_list args);
+
+/// @brief Take text of committed records out of the ring. Single consumer.
+///
+/// @param dest destination
+/// @param len size of destination, at least LOGRING_MAX_RECORD
+/// @return number of bytes written
+size_t logring_read(char *dest, size_t len);
+
+/// @brief Output all committed records with putnstr(). Single consumer.
+///
+/// @return number of bytes output
+size_t logring_drain(void);
+
+/// @brief Number of records dropped as the ring was full, reset on read.
+uint32_t logring_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_LOGRING_H */
@@ -0,0 +1,102 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file memcpy_async.h
+/// @brief Asynchronous bulk copy, offloaded to a platform DMA engine.
+///
+/// Copies are queued and performed by a backend in submission order, while
+/// the caller continues with other work. Each copy gets a ticket, which can be
+/// waited for with memcpy_wait(). Without a registered backend copies are done
+/// synchronously with memcpy().
+///
+/// Copies are submitted from a single context. A backend reports completion
+/// with memcpy_async_complete(), which may be called from an interrupt handler
+/// or a helper thread.
+
+#ifndef NOC_MEMCPY_ASYNC_H
+#define NOC_MEMCPY_ASYNC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Maximum number of queued copies, power of 2
+#ifndef MEMCPY_ASYNC_QUEUE
+#define MEMCPY_ASYNC_QUEUE 16
+#endif
+
+/// @brief Completion callback, called in the completion context.
+typedef void (*memcpy_async_cb_t)(void *dest, size_t len);
+
+/// @brief Ticket identifying a queued copy.
+typedef uint32_t memcpy_ticket_t;
+
+/// @brief Copy engine provided by platform.
+struct memcpy_async_ops {
+    /// @brief Start a copy. Only one copy is started at a time, its
+    /// completion is reported with memcpy_async_complete().
+    void (*start)(void *dest, const void *src, size_t len);
+
+    /// @brief Advance copy in progress, called while waiting. NULL if the
+    /// engine progresses on its own.
+    void (*poll)(void);
+
+    /// Shorter copies are done synchronously with memcpy() if nothing is
+    /// queued
+    size_t min_len;
+};
+
+/// @brief Register copy engine.
+///
+/// Must be called with no copies in flight.
+/// @param ops copy engine, NULL to copy synchronously
+void memcpy_async_register(const struct memcpy_async_ops *ops);
+
+/// @brief Report completion of the started copy. Called by backend.
+void memcpy_async_complete(void);
+
+/// @brief Queue copy of `len` bytes from `src` to `dest`.
+///
+/// Buffers must not be accessed until the copy is completed. Waits for a free
+/// slot if the queue is full.
+/// @param dest address of destination
+/// @param src address of source object
+/// @param len length in bytes
+/// @param cb callback called on completion, may be NULL
+/// @return ticket to pass to memcpy_wait() or memcpy_done()
+memcpy_ticket_t memcpy_async(void *restrict dest, const void *restrict src,
+                             size_t len, memcpy_async_cb_t cb);
+
+/// @brief Check if copy, and all copies submitted before it, are completed.
+///
+/// @param ticket ticket returned by memcpy_async()
+/// @return true if completed
+bool memcpy_done(memcpy_ticket_t ticket);
+
+/// @brief Wait for completion of copy and all copies submitted before it.
+///
+/// @param ticket ticket returned by memcpy_async()
+void memcpy_wait(memcpy_ticket_t ticket);
+
+/// @brief Let backend make progress without waiting.
+///
+/// Backends which need CPU time, like memcpy_async_soft, advance by one step.
+void memcpy_async_poll(void);
+
+/// @brief Software copy engine, copying MEMCPY_ASYNC_CHUNK bytes per
+/// memcpy_async_poll(). Allows overlapping copies with computation in steps
+/// and testing without hardware.
+extern const struct memcpy_async_ops memcpy_async_soft;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_MEMCPY_ASYNC_H */
@@ -29,6 +29,12 @@ extern "C" {
 #define PLATFORM_MAX_ADDR UINTPTR_MAX
 #endif
 
+#ifndef PLATFORM_PAGE_SIZE
+// Granularity of memory protection. Reads which don't cross this boundary
+// can't fault if the first byte is accessible.
+#define PLATFORM_PAGE_SIZE 4096
+#endif
+
 #define MIN(a, b)               \
     ({                          \
         __typeof__(a) _a = (a); \
@@ -36,6 +42,13 @@ extern "C" {
         (_a < _b) ? _a : _b;    \
     })
 
+#define MAX(a, b)               \
+    ({                          \
+        __typeof__(a) _a = (a); \
+        __typeof__(b) _b = (b); \
+        (_a > _b) ? _a : _b;    \
+    })
+
 #ifdef NDEBUG
 #define LOG(s, ...) printf(s, __VA_ARGS__)
 #else
@@ -74,6 +87,27 @@ static inline uint32_t stdc_leading_zerosui(uint32_t x) {
     return (x) ? (uint32_t)__builtin_clz(x) : 32U;
 }
 
+/// @brief Count trailing zeroes
+/// @param x input argument
+/// @return trailing zeroes in `x`, 32 if x == 0
+static inline uint32_t stdc_trailing_zerosui(uint32_t x) {
+    return (x) ? (uint32_t)__builtin_ctz(x) : 32U;
+}
+
+/// @brief Count leading zeroes
+/// @param x input argument
+/// @return leading zeroes in `x`, width of unsigned long if x == 0
+static inline uint32_t stdc_leading_zerosul(unsigned long x) {
+    return (x) ? (uint32_t)__builtin_clzl(x) : sizeof(x) * 8U;
+}
+
+/// @brief Count trailing zeroes
+/// @param x input argument
+/// @return trailing zeroes in `x`, width of unsigned long if x == 0
+static inline uint32_t stdc_trailing_zerosul(unsigned long x) {
+    return (x) ? (uint32_t)__builtin_ctzl(x) : sizeof(x) * 8U;
+}
+
 #ifdef __cplusplus
 }
 #endif
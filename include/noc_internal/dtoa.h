@@ -0,0 +1,56 @@
+/**
+ * @file noc_internal/dtoa.h
+ * @brief Internal floating-point to text conversion for formatter()
+ *
+ * Digits are produced with Ryu, the shortest decimal representation which
+ * rounds back to the same double, using only integer arithmetic. When more
+ * digits are requested than the shortest ones determine, exact digits are
+ * computed with big integer arithmetic.
+ */
+#ifndef NOC_INTERNAL_DTOA_H
+#define NOC_INTERNAL_DTOA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Largest precision supported by dtoa_format()
+#define DTOA_MAX_PRECISION 128
+
+/// Precision of %g for the shortest round-trip digits
+#define DTOA_SHORTEST (-2)
+
+// Formatted number without sign. Text parts are stored back to back in `buf`
+// and output as: part 0, zeros[0] times '0', part 1, zeros[1] times '0',
+// part 2. Long runs of zeroes of %f are not stored. The buffer holds all
+// digits of the integer part of the largest double.
+struct dtoa_text {
+    char buf[320];
+    uint16_t len[3];
+    bool negative;
+    bool finite;
+    uint32_t zeros[2];
+};
+
+/// @brief Format double for printf() conversion.
+///
+/// Digits are exact, like in C. With DTOA_SHORTEST %g prints the shortest
+/// representation, but at least 6 significant digits.
+/// @param t output text
+/// @param value value to format
+/// @param conv conversion, one of "aAeEfFgG"
+/// @param prec precision up to DTOA_MAX_PRECISION, negative if not specified,
+/// or DTOA_SHORTEST
+/// @param alt alternative form, '#' flag
+void dtoa_format(struct dtoa_text *t, double value, char conv, int32_t prec,
+                 bool alt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NOC_INTERNAL_DTOA_H
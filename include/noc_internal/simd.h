@@ -0,0 +1,238 @@
+/**
+ * @file noc_internal/simd.h
+ * @brief Internal vector helpers for x86_64 SSE2/AVX2 kernels
+ *
+ * Kernels are written once against `vec_t` and `VEC_SIZE`, the widest vector
+ * enabled at compile time (AVX2 if available, SSE2 otherwise). When no vector
+ * unit is available NOC_SIMD is not defined and generic code is used.
+ */
+#ifndef NOC_INTERNAL_SIMD_H
+#define NOC_INTERNAL_SIMD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "noc_internal/common.h"
+
+#if defined(ARCH_X86_64) && defined(__SSE2__)
+#include <immintrin.h>
+
+#define NOC_SIMD 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bit mask with one bit per vector byte, bit 0 for the lowest address
+typedef uint32_t vec_mask_t;
+
+#if defined(__AVX2__)
+typedef __m256i vec_t;
+#define VEC_SIZE 32
+#define VEC_MASK_ALL 0xffffffffU
+
+static inline vec_t vec_loadu(const void *p) {
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline vec_t vec_load(const void *p) {
+    return _mm256_load_si256((const __m256i *)p);
+}
+
+static inline void vec_storeu(void *p, vec_t v) {
+    _mm256_storeu_si256((__m256i *)p, v);
+}
+
+static inline void vec_store(void *p, vec_t v) {
+    _mm256_store_si256((__m256i *)p, v);
+}
+
+static inline vec_t vec_zero(void) { return _mm256_setzero_si256(); }
+
+static inline vec_t vec_set1(uint8_t c) { return _mm256_set1_epi8((char)c); }
+
+static inline vec_t vec_set1_64(uint64_t x) {
+    return _mm256_set1_epi64x((long long)x);
+}
+
+static inline vec_t vec_cmpeq(vec_t a, vec_t b) {
+    return _mm256_cmpeq_epi8(a, b);
+}
+
+static inline vec_t vec_min(vec_t a, vec_t b) { return _mm256_min_epu8(a, b); }
+
+static inline vec_t vec_and(vec_t a, vec_t b) {
+    return _mm256_and_si256(a, b);
+}
+
+static inline vec_t vec_or(vec_t a, vec_t b) {
+    return _mm256_or_si256(a, b);
+}
+
+static inline vec_t vec_xor(vec_t a, vec_t b) {
+    return _mm256_xor_si256(a, b);
+}
+
+static inline vec_mask_t vec_movemask(vec_t v) {
+    return (vec_mask_t)_mm256_movemask_epi8(v);
+}
+
+static inline vec_t vec_srli16(vec_t v, int n) {
+    return _mm256_srli_epi16(v, n);
+}
+
+static inline vec_t vec_srli64(vec_t v, int n) {
+    return _mm256_srli_epi64(v, n);
+}
+
+static inline vec_t vec_add64(vec_t a, vec_t b) {
+    return _mm256_add_epi64(a, b);
+}
+
+// Load 16 bytes into every 128-bit lane
+static inline vec_t vec_broadcast16(const void *p) {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)p));
+}
+
+#define NOC_SIMD_SHUFFLE 1
+// Byte lookup in `tbl` within each 128-bit lane, zero if index bit 7 is set
+static inline vec_t vec_shuffle(vec_t tbl, vec_t idx) {
+    return _mm256_shuffle_epi8(tbl, idx);
+}
+#else
+typedef __m128i vec_t;
+#define VEC_SIZE 16
+#define VEC_MASK_ALL 0xffffU
+
+static inline vec_t vec_loadu(const void *p) {
+    return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline vec_t vec_load(const void *p) {
+    return _mm_load_si128((const __m128i *)p);
+}
+
+static inline void vec_storeu(void *p, vec_t v) {
+    _mm_storeu_si128((__m128i *)p, v);
+}
+
+static inline void vec_store(void *p, vec_t v) {
+    _mm_store_si128((__m128i *)p, v);
+}
+
+static inline vec_t vec_zero(void) { return _mm_setzero_si128(); }
+
+static inline vec_t vec_set1(uint8_t c) { return _mm_set1_epi8((char)c); }
+
+static inline vec_t vec_set1_64(uint64_t x) {
+    return _mm_set1_epi64x((long long)x);
+}
+
+static inline vec_t vec_cmpeq(vec_t a, vec_t b) { return _mm_cmpeq_epi8(a, b); }
+
+static inline vec_t vec_min(vec_t a, vec_t b) { return _mm_min_epu8(a, b); }
+
+static inline vec_t vec_and(vec_t a, vec_t b) { return _mm_and_si128(a, b); }
+
+static inline vec_t vec_or(vec_t a, vec_t b) { return _mm_or_si128(a, b); }
+
+static inline vec_t vec_xor(vec_t a, vec_t b) { return _mm_xor_si128(a, b); }
+
+static inline vec_mask_t vec_movemask(vec_t v) {
+    return (vec_mask_t)_mm_movemask_epi8(v);
+}
+
+static inline vec_t vec_srli16(vec_t v, int n) { return _mm_srli_epi16(v, n); }
+
+static inline vec_t vec_srli64(vec_t v, int n) { return _mm_srli_epi64(v, n); }
+
+static inline vec_t vec_add64(vec_t a, vec_t b) { return _mm_add_epi64(a, b); }
+
+// Load 16 bytes into every 128-bit lane
+static inline vec_t vec_broadcast16(const void *p) {
+    return _mm_loadu_si128((const __m128i *)p);
+}
+
+#if defined(__SSSE3__)
+#define NOC_SIMD_SHUFFLE 1
+// Byte lookup in `tbl` within each 128-bit lane, zero if index bit 7 is set
+static inline vec_t vec_shuffle(vec_t tbl, vec_t idx) {
+    return _mm_shuffle_epi8(tbl, idx);
+}
+#endif
+#endif
+
+// Mask of bytes equal in `a` and `b`
+static inline vec_mask_t vec_eq_mask(vec_t a, vec_t b) {
+    return vec_movemask(vec_cmpeq(a, b));
+}
+
+// Mask of first `n` bytes, n <= VEC_SIZE
+static inline vec_mask_t vec_mask_below(size_t n) {
+    return (vec_mask_t)(((uint64_t)1 << n) - 1);
+}
+
+// Round pointer down to vector alignment
+static inline const uint8_t *vec_align_down(const void *p) {
+    return (const uint8_t *)((uintptr_t)p & ~(uintptr_t)(VEC_SIZE - 1));
+}
+
+// Check if all bytes are zero
+static inline bool vec_is_zero(vec_t v) {
+    return vec_eq_mask(v, vec_zero()) == VEC_MASK_ALL;
+}
+
+// Unaligned vector load at `p` can't fault if it doesn't cross a page.
+static inline bool vec_page_safe(const void *p) {
+    return ((uintptr_t)p & (PLATFORM_PAGE_SIZE - 1)) <=
+           PLATFORM_PAGE_SIZE - VEC_SIZE;
+}
+
+// Copy up to 2 * VEC_SIZE bytes. All loads are issued before any store, so
+// this is safe for overlapping buffers in either direction.
+static inline void vec_move_short(void *dest, const void *src, size_t len) {
+    uint8_t *d = (uint8_t *)dest;
+    const uint8_t *s = (const uint8_t *)src;
+    if (len >= VEC_SIZE) {
+        vec_t head = vec_loadu(s);
+        vec_t tail = vec_loadu(s + len - VEC_SIZE);
+        vec_storeu(d, head);
+        vec_storeu(d + len - VEC_SIZE, tail);
+#if VEC_SIZE > 16
+    } else if (len >= 16) {
+        __m128i head = _mm_loadu_si128((const __m128i *)s);
+        __m128i tail = _mm_loadu_si128((const __m128i *)(s + len - 16));
+        _mm_storeu_si128((__m128i *)d, head);
+        _mm_storeu_si128((__m128i *)(d + len - 16), tail);
+#endif
+    } else if (len >= 8) {
+        uint64_t head, tail;
+        __builtin_memcpy(&head, s, 8);
+        __builtin_memcpy(&tail, s + len - 8, 8);
+        __builtin_memcpy(d, &head, 8);
+        __builtin_memcpy(d + len - 8, &tail, 8);
+    } else if (len >= 4) {
+        uint32_t head, tail;
+        __builtin_memcpy(&head, s, 4);
+        __builtin_memcpy(&tail, s + len - 4, 4);
+        __builtin_memcpy(d, &head, 4);
+        __builtin_memcpy(d + len - 4, &tail, 4);
+    } else if (len >= 2) {
+        uint16_t head, tail;
+        __builtin_memcpy(&head, s, 2);
+        __builtin_memcpy(&tail, s + len - 2, 2);
+        __builtin_memcpy(d, &head, 2);
+        __builtin_memcpy(d + len - 2, &tail, 2);
+    } else if (len) {
+        *d = *s;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ARCH_X86_64 && __SSE2__
+
+#endif /* NOC_INTERNAL_SIMD_H */
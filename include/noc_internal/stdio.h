@@ -0,0 +1,34 @@
+/**
+ * @file noc_internal/stdio.h
+ * @brief Internal stream output for formatter() sinks
+ */
+#ifndef NOC_INTERNAL_STDIO_H
+#define NOC_INTERNAL_STDIO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Append text to the stream buffer, writing out the buffer when full.
+/// @return false on write error
+bool file_write(FILE *f, const char *str, size_t len);
+
+/// @brief Append `len` copies of `c` to the stream buffer.
+/// @return false on write error
+bool file_fill(FILE *f, char c, size_t len);
+
+/// @brief Finish a call writing to the stream, flush per buffering mode.
+/// @param f output stream
+/// @param res result of the call
+/// @return `res`, or EOF if flush failed
+int file_done(FILE *f, int res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NOC_INTERNAL_STDIO_H
@@ -0,0 +1,108 @@
+/**
+ * @file noc_internal/swar.h
+ * @brief Internal word-at-a-time (SWAR) helpers
+ *
+ * A word is `uintptr_t`, same as in the generic memcpy() and memset(). Bytes
+ * are numbered in memory order, so results don't depend on endianness.
+ */
+#ifndef NOC_INTERNAL_SWAR_H
+#define NOC_INTERNAL_SWAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "noc_internal/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Mask to check word alignment
+#define SWAR_MASK (sizeof(uintptr_t) - 1)
+
+// 0x01 and 0x80 in every byte of a word
+#define SWAR_ONES (UINTPTR_MAX / 0xff)
+#define SWAR_HIGHS (SWAR_ONES << 7)
+
+/// @brief Replicate byte into every byte of a word
+/// @param c byte value
+/// @return word with `c` in every byte
+static inline uintptr_t swar_repeat(uint8_t c) { return SWAR_ONES * c; }
+
+/// @brief Set high bit in every zero byte of a word, exactly.
+/// @param x word
+/// @return word with 0x80 in bytes which were zero, 0 in other bytes
+static inline uintptr_t swar_zero_bytes(uintptr_t x) {
+    return ~(((x & ~SWAR_HIGHS) + ~SWAR_HIGHS) | x | ~SWAR_HIGHS);
+}
+
+/// @brief Check for zero byte in a word.
+///
+/// Classic `(x - 0x01..) & ~x & 0x80..` test, one operation cheaper than
+/// swar_zero_bytes(). A borrow may set bits in bytes above a zero byte, so
+/// the result is only good to locate the first zero byte in memory order,
+/// which is the case for little-endian only.
+/// @param x word
+/// @return non-zero if any byte is zero
+static inline uintptr_t swar_has_zero(uintptr_t x) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return (x - SWAR_ONES) & ~x & SWAR_HIGHS;
+#else
+    return swar_zero_bytes(x);
+#endif
+}
+
+/// @brief Mask of bytes with index below `n` in memory order
+/// @param n number of bytes, less than size of word
+/// @return word with 0xff in first `n` bytes
+static inline uintptr_t swar_mask_below(size_t n) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return ((uintptr_t)1 << (n * 8)) - 1;
+#else
+    return ~(UINTPTR_MAX >> (n * 8));
+#endif
+}
+
+/// @brief Index of the first (lowest addressed) non-zero byte in a word.
+///
+/// On little-endian targets this is the count of trailing zeroes, which is
+/// the same as leading zeroes of the byte-swapped word.
+/// @param x word, must be non-zero
+/// @return byte index in memory order
+static inline size_t swar_first_byte(uintptr_t x) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return stdc_trailing_zerosul(x) / 8;
+#else
+    return (stdc_leading_zerosul(x) - (sizeof(long) - sizeof(x)) * 8) / 8;
+#endif
+}
+
+/// @brief Index of the last (highest addressed) non-zero byte in a word.
+/// @param x word, must be non-zero
+/// @return byte index in memory order
+static inline size_t swar_last_byte(uintptr_t x) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return sizeof(x) - 1 -
+           (stdc_leading_zerosul(x) - (sizeof(long) - sizeof(x)) * 8) / 8;
+#else
+    return sizeof(x) - 1 - stdc_trailing_zerosul(x) / 8;
+#endif
+}
+
+/// @brief Extract byte from a word
+/// @param x word
+/// @param i byte index in memory order
+/// @return byte value
+static inline uint8_t swar_byte(uintptr_t x, size_t i) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return (uint8_t)(x >> (i * 8));
+#else
+    return (uint8_t)(x >> ((sizeof(x) - 1 - i) * 8));
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_INTERNAL_SWAR_H */
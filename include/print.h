@@ -0,0 +1,223 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file print.h
+/// @brief Type-generic output without format strings.
+///
+/// noc_print(a, b, c) prints its arguments one after another, each according
+/// to its type: integers in decimal, `char` as a character, strings as text,
+/// floating point numbers as the shortest round-trip representation in the
+/// style of %g, other pointers like %p. Options are attached to a value with
+/// noc_hex(), noc_pad(), noc_zpad() and noc_prec(), which can be nested:
+///
+///     noc_print("addr ", noc_zpad(noc_hex(addr), 8), " len ", len, "\n");
+///
+/// The emitter of each argument is selected at compile time with _Generic,
+/// nothing is parsed at run time and no variable arguments are used. Emitters
+/// share conversion routines with printf(), but are separate functions, so
+/// conversions which are not used, e.g. floating point, are removed by the
+/// linker with --gc-sections.
+
+#ifndef NOC_PRINT_H
+#define NOC_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Flags of struct noc_arg: left-justify, pad with zeroes, precision is set
+#define NOC_LEFT 1
+#define NOC_ZERO 2
+#define NOC_PREC 4
+
+struct noc_arg;
+
+/// Emitter of a value, returns number of characters written or EOF
+typedef int (*noc_emit_t)(FILE *f, const struct noc_arg *a);
+
+/// @brief Value to print with its emitter and options, made by noc_arg().
+struct noc_arg {
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char *s;
+        const void *p;
+    } v;                 ///< Value
+    uint16_t width;      ///< Minimum field width
+    uint16_t precision;  ///< Precision, if NOC_PREC flag is set
+    uint8_t flags;       ///< NOC_LEFT, NOC_ZERO, NOC_PREC
+    char conv;           ///< Conversion as in printf(), e.g. 'd', 'x', 'g'
+    uint8_t _pad[2];
+    noc_emit_t emit;  ///< Emitter for type of value
+#if UINTPTR_MAX == UINT32_MAX
+    uint32_t _pad2;
+#endif
+};
+
+/// @name Emitters, called by noc_print()
+/// @{
+int noc_emit_i32(FILE *f, const struct noc_arg *a);
+int noc_emit_i64(FILE *f, const struct noc_arg *a);
+int noc_emit_u32(FILE *f, const struct noc_arg *a);
+int noc_emit_u64(FILE *f, const struct noc_arg *a);
+int noc_emit_char(FILE *f, const struct noc_arg *a);
+int noc_emit_str(FILE *f, const struct noc_arg *a);
+int noc_emit_ptr(FILE *f, const struct noc_arg *a);
+int noc_emit_double(FILE *f, const struct noc_arg *a);
+/// @}
+
+/// @brief Print values to the stream.
+///
+/// Stream is flushed once at the end according to its buffering mode.
+/// @param f output stream
+/// @param args values to print
+/// @param n number of values
+/// @return number of characters written, or EOF on error
+int noc_fprint_n(FILE *f, const struct noc_arg *args, size_t n);
+
+static inline struct noc_arg noc_arg_i32(int32_t v) {
+    return (struct noc_arg){.v.i = v, .conv = 'd', .emit = noc_emit_i32};
+}
+
+static inline struct noc_arg noc_arg_i64(int64_t v) {
+    return (struct noc_arg){.v.i = v, .conv = 'd', .emit = noc_emit_i64};
+}
+
+static inline struct noc_arg noc_arg_u32(uint32_t v) {
+    return (struct noc_arg){.v.u = v, .conv = 'u', .emit = noc_emit_u32};
+}
+
+static inline struct noc_arg noc_arg_u64(uint64_t v) {
+    return (struct noc_arg){.v.u = v, .conv = 'u', .emit = noc_emit_u64};
+}
+
+static inline struct noc_arg noc_arg_long(long v) {
+    return sizeof(long) == sizeof(int64_t) ? noc_arg_i64(v)
+                                           : noc_arg_i32((int32_t)v);
+}
+
+static inline struct noc_arg noc_arg_ulong(unsigned long v) {
+    return sizeof(long) == sizeof(int64_t) ? noc_arg_u64(v)
+                                           : noc_arg_u32((uint32_t)v);
+}
+
+static inline struct noc_arg noc_arg_char(char v) {
+    return (struct noc_arg){.v.i = v, .conv = 'c', .emit = noc_emit_char};
+}
+
+static inline struct noc_arg noc_arg_str(const char *v) {
+    return (struct noc_arg){.v.s = v, .conv = 's', .emit = noc_emit_str};
+}
+
+static inline struct noc_arg noc_arg_ptr(const void *v) {
+    return (struct noc_arg){.v.p = v, .conv = 'p', .emit = noc_emit_ptr};
+}
+
+static inline struct noc_arg noc_arg_double(double v) {
+    return (struct noc_arg){.v.d = v, .conv = 'g', .emit = noc_emit_double};
+}
+
+static inline struct noc_arg noc_arg_self(struct noc_arg v) { return v; }
+
+/// @brief Make struct noc_arg from value of any supported type.
+#define noc_arg(x)                                   \
+    _Generic((x),                                    \
+        struct noc_arg: noc_arg_self,                \
+        _Bool: noc_arg_u32,                          \
+        char: noc_arg_char,                          \
+        signed char: noc_arg_i32,                    \
+        short: noc_arg_i32,                          \
+        int: noc_arg_i32,                            \
+        long: noc_arg_long,                          \
+        long long: noc_arg_i64,                      \
+        unsigned char: noc_arg_u32,                  \
+        unsigned short: noc_arg_u32,                 \
+        unsigned int: noc_arg_u32,                   \
+        unsigned long: noc_arg_ulong,                \
+        unsigned long long: noc_arg_u64,             \
+        float: noc_arg_double,                       \
+        double: noc_arg_double,                      \
+        char *: noc_arg_str,                         \
+        const char *: noc_arg_str,                   \
+        default: noc_arg_ptr)(x)
+
+static inline struct noc_arg noc_arg_conv(struct noc_arg a, char conv) {
+    a.conv = conv;
+    return a;
+}
+
+static inline struct noc_arg noc_arg_pad(struct noc_arg a, int width,
+                                         uint8_t flags) {
+    a.flags |= flags | (width < 0 ? NOC_LEFT : 0);
+    a.width = (uint16_t)(width < 0 ? -width : width);
+    return a;
+}
+
+static inline struct noc_arg noc_arg_prec(struct noc_arg a, int precision) {
+    a.flags |= NOC_PREC;
+    a.precision = (uint16_t)precision;
+    return a;
+}
+
+/// Print integer in lowercase hexadecimal, double in hexadecimal floating
+/// point
+#define noc_hex(x) noc_arg_conv(noc_arg(x), 'x')
+
+/// Pad with spaces to `width` characters, on the right if `width` is negative
+#define noc_pad(x, width) noc_arg_pad(noc_arg(x), (width), 0)
+
+/// Pad number with zeroes to `width` characters
+#define noc_zpad(x, width) noc_arg_pad(noc_arg(x), (width), NOC_ZERO)
+
+/// Set precision: digits of number, maximum length of string
+#define noc_prec(x, precision) noc_arg_prec(noc_arg(x), (precision))
+
+// Apply noc_arg() to up to 16 arguments
+#define NOC_NARG_(...)                                                      \
+    NOC_NARG_N_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, \
+                2, 1)
+#define NOC_NARG_N_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, \
+                    _14, _15, _16, N, ...)                                 \
+    N
+#define NOC_CAT_(a, b) NOC_CAT2_(a, b)
+#define NOC_CAT2_(a, b) a##b
+#define NOC_MAP_1(x) noc_arg(x)
+#define NOC_MAP_2(x, ...) noc_arg(x), NOC_MAP_1(__VA_ARGS__)
+#define NOC_MAP_3(x, ...) noc_arg(x), NOC_MAP_2(__VA_ARGS__)
+#define NOC_MAP_4(x, ...) noc_arg(x), NOC_MAP_3(__VA_ARGS__)
+#define NOC_MAP_5(x, ...) noc_arg(x), NOC_MAP_4(__VA_ARGS__)
+#define NOC_MAP_6(x, ...) noc_arg(x), NOC_MAP_5(__VA_ARGS__)
+#define NOC_MAP_7(x, ...) noc_arg(x), NOC_MAP_6(__VA_ARGS__)
+#define NOC_MAP_8(x, ...) noc_arg(x), NOC_MAP_7(__VA_ARGS__)
+#define NOC_MAP_9(x, ...) noc_arg(x), NOC_MAP_8(__VA_ARGS__)
+#define NOC_MAP_10(x, ...) noc_arg(x), NOC_MAP_9(__VA_ARGS__)
+#define NOC_MAP_11(x, ...) noc_arg(x), NOC_MAP_10(__VA_ARGS__)
+#define NOC_MAP_12(x, ...) noc_arg(x), NOC_MAP_11(__VA_ARGS__)
+#define NOC_MAP_13(x, ...) noc_arg(x), NOC_MAP_12(__VA_ARGS__)
+#define NOC_MAP_14(x, ...) noc_arg(x), NOC_MAP_13(__VA_ARGS__)
+#define NOC_MAP_15(x, ...) noc_arg(x), NOC_MAP_14(__VA_ARGS__)
+#define NOC_MAP_16(x, ...) noc_arg(x), NOC_MAP_15(__VA_ARGS__)
+
+/// @brief Print up to 16 values to the stream, see noc_fprint_n().
+#define noc_fprint(f, ...)                                                  \
+    noc_fprint_n((f),                                                       \
+                 (const struct noc_arg[]){NOC_CAT_(                         \
+                     NOC_MAP_, NOC_NARG_(__VA_ARGS__))(__VA_ARGS__)},       \
+                 NOC_NARG_(__VA_ARGS__))
+
+/// @brief Print up to 16 values to standard output, see noc_fprint_n().
+#define noc_print(...) noc_fprint(stdout, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_PRINT_H */
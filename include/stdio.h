@@ -12,6 +12,7 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +21,152 @@ extern "C" {
 // The value returned by puts() and similar functions to indicate error
 #define EOF (-1)
 
+/// Fully buffered, output when the buffer is full, see setvbuf()
+#define _IOFBF 0
+/// Line buffered, output at the end of a call which wrote a new-line
+#define _IOLBF 1
+/// Unbuffered, output at the end of each call
+#define _IONBF 2
+
+/// Size of the standard output buffer
+#ifndef BUFSIZ
+#define BUFSIZ 1024
+#endif
+
+/// @brief Device behind a stream, see FILE_INIT().
+struct file_ops {
+    /// @brief Write `len` bytes. NULL for input only stream.
+    /// @return number of bytes written, negative on error
+    intptr_t (*write)(void *cookie, const char *buf, size_t len);
+
+    /// @brief Read up to `len` bytes. NULL for output only stream.
+    /// @return number of bytes read, 0 at end of input, negative on error
+    intptr_t (*read)(void *cookie, char *buf, size_t len);
+};
+
+/// @brief Stream.
+///
+/// Output is collected in the buffer and written out according to the
+/// buffering mode. Input is read directly into the destination. Streams are
+/// not reentrant, use logring.h from interrupt handlers and concurrent
+/// threads.
+typedef struct FILE {
+    char *buf;                   ///< Output buffer
+    size_t size;                 ///< Size of buffer
+    size_t len;                  ///< Number of buffered characters
+    const struct file_ops *ops;  ///< Device
+    void *cookie;                ///< Argument for `ops` callbacks
+    int mode;                    ///< Buffering mode, _IOFBF, _IOLBF, _IONBF
+    int flags;                   ///< Internal state
+} FILE;
+
+/// @brief Initializer of a stream with user defined device.
+///
+/// Such streams are not tracked by the library: fflush(NULL) and exit() only
+/// flush standard output, so buffered output must be flushed by hand with
+/// fflush() before the stream is abandoned.
+/// @param ops_ device callbacks, `struct file_ops *`
+/// @param cookie_ argument passed to callbacks
+/// @param buf_ output buffer, may be NULL for input only stream
+/// @param size_ size of output buffer
+/// @param mode_ buffering mode, one of _IOFBF, _IOLBF, _IONBF
+#define FILE_INIT(ops_, cookie_, buf_, size_, mode_)                        \
+    {                                                                       \
+        .buf = (buf_), .size = (size_), .ops = (ops_), .cookie = (cookie_), \
+        .mode = (mode_)                                                     \
+    }
+
+/// Standard output, line buffered by default
+extern FILE *const stdout;
+
+/// @brief Set buffering mode and buffer of the stream.
+///
+/// Buffered output is flushed first. The buffer of _IONBF stream still
+/// collects output of a single call, so that it takes one write.
+/// @param stream output stream
+/// @param buf new buffer, or NULL to keep the current one. The buffer must
+/// remain valid while the stream is used.
+/// @param mode buffering mode, one of _IOFBF, _IOLBF, _IONBF
+/// @param size size of `buf`, must be nonzero
+/// @return 0 on success, nonzero if mode is invalid or flush failed
+int setvbuf(FILE *restrict stream, char *restrict buf, int mode, size_t size);
+
+/// @brief Write out buffered output of the stream.
+///
+/// Unlike in C, NULL flushes only standard output, see FILE_INIT().
+/// @param stream output stream, or NULL for standard output
+/// @return 0 on success, EOF on error
+int fflush(FILE *stream);
+
+/// @brief Write character to standard output.
+///
+/// @param c character to write, converted to unsigned char
+/// @return the character written, or EOF on error
+int putchar(int c);
+
+/// @brief Write string to the stream, without the terminating null character.
+///
+/// @param s string to write
+/// @param stream output stream
+/// @return a nonnegative number on success, or EOF on error
+int fputs(const char *restrict s, FILE *restrict stream);
+
+/// @brief Write `nmemb` elements of `size` bytes to the stream.
+///
+/// @param ptr elements to write
+/// @param size size of element
+/// @param nmemb number of elements
+/// @param stream output stream
+/// @return number of elements written, less than `nmemb` only on error
+size_t fwrite(const void *restrict ptr, size_t size, size_t nmemb,
+              FILE *restrict stream);
+
+/// @brief Read up to `nmemb` elements of `size` bytes from the stream.
+///
+/// Reads are not buffered, the device is called until the request is
+/// complete or input ends.
+/// @param ptr destination
+/// @param size size of element
+/// @param nmemb number of elements
+/// @param stream input stream
+/// @return number of complete elements read
+size_t fread(void *restrict ptr, size_t size, size_t nmemb,
+             FILE *restrict stream);
+
+/// @brief Borrow free space of the stream buffer to write output in place.
+///
+/// Buffered output is written out if less than `min` bytes are free. The
+/// space is owned by the caller until fcommit(), no other output to the
+/// stream is allowed meanwhile.
+/// @param stream output stream
+/// @param min minimum free space required
+/// @param avail set to the size of free space
+/// @return pointer to free space, NULL if buffer is smaller than `min` or
+/// flush failed
+char *fborrow(FILE *restrict stream, size_t min, size_t *restrict avail);
+
+/// @brief Add `len` bytes written in place after fborrow() to the output.
+///
+/// @param stream output stream
+/// @param len number of bytes written, at most the available space
+/// @return 0 on success, EOF if flush failed
+int fcommit(FILE *stream, size_t len);
+
+/// @brief Formatted print to stream, see printf().
+/// @param stream output stream
+/// @param format format string
+/// @param ... arguments to print
+/// @return number of characters written, negative on error
+int fprintf(FILE *restrict stream, const char *restrict format, ...)
+    __attribute__((__format__(__printf__, 2, 3)));
+
+/// @brief Formatted print to stream, see printf() and vsnprintf().
+/// @param stream output stream
+/// @param format format string
+/// @param arg input arguments
+/// @return number of characters written, negative on error
+int vfprintf(FILE *restrict stream, const char *restrict format, va_list arg);
+
 /// @brief Formatted print on standard output.
 ///
 /// The printf function writes output to standard output, under control of the
@@ -58,7 +205,8 @@ extern "C" {
 ///   * A conversion specifier character that specifies the type of conversion
 ///     to be applied.
 /// Supported formats: %d (int), %u(unsigned int), %s(char *), %c (unsigned
-/// char)
+/// char), %f %e %g %a (double). Floating point digits are correctly rounded
+/// from the exact value, precision is limited to 128.
 ///
 /// @param format format string
 /// @param ... arguments to print
@@ -67,6 +215,9 @@ int printf(const char *format, ...)
     __attribute__((__format__(__printf__, 1, 2)));
 
 /// @brief Formatted output to string with length control.
+///
+/// With `n` equal to zero nothing is written and `s` may be NULL, the output
+/// is only counted, which is cheaper than formatting into a buffer.
 /// @param s destination string buffer
 /// @param n size of destination buffer
 /// @param format format string
@@ -99,6 +250,87 @@ int snprintf(char *restrict s, size_t n, const char *restrict format, ...)
 int vsnprintf(char *restrict s, size_t n, const char *restrict format,
               va_list arg);
 
+/// @brief Formatted output to allocated string.
+///
+/// The string is formatted in a single pass into a buffer growing with
+/// realloc(), see strbuf.h.
+/// @param strp set to the allocated string, to be released with free(), or
+/// NULL on error
+/// @param format format string
+/// @param ... input arguments
+/// @return number of characters written, not counting the terminating null
+/// character, or EOF if allocation failed or format is invalid
+int asprintf(char **restrict strp, const char *restrict format, ...)
+    __attribute__((__format__(__printf__, 2, 3)));
+
+/// @brief Formatted output to allocated string, see asprintf().
+/// @param strp set to the allocated string, or NULL on error
+/// @param format format string
+/// @param arg input arguments
+/// @return number of characters written, or EOF on error
+int vasprintf(char **restrict strp, const char *restrict format, va_list arg);
+
+/// Maximum number of steps in a compiled format, see printf_compile()
+#ifndef PRINTF_COMPILED_OPS
+#define PRINTF_COMPILED_OPS 16
+#endif
+
+/// @brief Step of compiled format: literal text followed by a conversion.
+struct printf_op {
+    uint16_t literal;      ///< Offset of literal text in format
+    uint16_t literal_len;  ///< Length of literal text
+    uint32_t spec;         ///< Conversion flags, 0 for literal text only
+    uint16_t width;        ///< Field width
+    uint16_t precision;    ///< Precision
+};
+
+/// @brief Format string parsed by printf_compile().
+struct printf_compiled {
+    const char *format;  ///< Format string, source of literal text
+    size_t count;        ///< Number of steps
+    struct printf_op op[PRINTF_COMPILED_OPS];
+};
+
+/// @brief Parse format string once for repeated printf_compiled() and
+/// snprintf_compiled() calls.
+///
+/// Flags, width, precision and length modifiers are decoded at this point,
+/// formatting only converts arguments and copies literal text. The format
+/// string is referenced, not copied, and must remain valid.
+/// @param format format string, as for printf()
+/// @param compiled compiled format
+/// @return 0 on success, EOF if format is invalid or has more than
+/// PRINTF_COMPILED_OPS conversions
+int printf_compile(const char *format, struct printf_compiled *compiled);
+
+/// @brief Formatted print on standard output with compiled format.
+///
+/// Arguments are not checked by compiler against the format.
+/// @param compiled format compiled with printf_compile()
+/// @param ... arguments to print
+/// @return number of characters written
+int printf_compiled(const struct printf_compiled *compiled, ...);
+
+/// @brief Formatted output to string with compiled format, see snprintf().
+/// @param s destination string buffer
+/// @param n size of destination buffer
+/// @param compiled format compiled with printf_compile()
+/// @param ... input arguments
+/// @return the number of characters that would have been written had n been
+/// sufficiently large, not counting the terminating null character
+int snprintf_compiled(char *restrict s, size_t n,
+                      const struct printf_compiled *compiled, ...);
+
+/// @brief Formatted output to string with compiled format, see vsnprintf().
+/// @param s destination string buffer
+/// @param n size of destination buffer
+/// @param compiled format compiled with printf_compile()
+/// @param arg input arguments
+/// @return the number of characters that would have been written had n been
+/// sufficiently large, not counting the terminating null character
+int vsnprintf_compiled(char *restrict s, size_t n,
+                       const struct printf_compiled *compiled, va_list arg);
+
 /// @brief Writes the string s and a trailing newline to standard output
 /// @param s string to print
 /// @return a nonnegative number on success, or EOF on error.
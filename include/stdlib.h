@@ -97,6 +97,24 @@ unsigned long int strtoul(const char *restrict nptr, char **restrict endptr,
                           int base);
 unsigned long long int strtoull(const char *restrict nptr,
                                 char **restrict endptr, int base);
+
+/// Buffer size sufficient for any value converted by u64toa() or i64toa()
+#define UTOA_BUFFER_SIZE 21
+
+/// @brief Convert unsigned integer to decimal string.
+///
+/// Digits are produced two at a time, with at most two 64-bit divisions.
+/// @param value value to convert
+/// @param str destination, UTOA_BUFFER_SIZE bytes are always enough
+/// @return pointer to the terminating null character in `str`
+char *u64toa(uint64_t value, char *str);
+
+/// @brief Convert signed integer to decimal string.
+///
+/// @param value value to convert
+/// @param str destination, UTOA_BUFFER_SIZE bytes are always enough
+/// @return pointer to the terminating null character in `str`
+char *i64toa(int64_t value, char *str);
 /// @}
 
 /// @defgroup a4  Pseudo-random sequence generation functions
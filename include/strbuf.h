@@ -0,0 +1,93 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file strbuf.h
+/// @brief Growable string builder on top of realloc().
+///
+/// The buffer grows geometrically, so building a string of length n costs
+/// O(n) copies and O(log n) reallocations. Formatted output is produced in a
+/// single pass directly into the buffer. The string is kept null-terminated
+/// once anything is added.
+
+#ifndef NOC_STRBUF_H
+#define NOC_STRBUF_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Smallest allocation of a string builder
+#ifndef STRBUF_MIN_SIZE
+#define STRBUF_MIN_SIZE 64
+#endif
+
+/// @brief String builder, initialize with STRBUF_INIT.
+struct strbuf {
+    char *buf;    ///< Null-terminated string, NULL if nothing allocated
+    size_t len;   ///< Length of string
+    size_t size;  ///< Allocated size of `buf`
+};
+
+/// Initializer of empty string builder
+#define STRBUF_INIT \
+    { .buf = NULL, .len = 0, .size = 0 }
+
+/// @brief Make room for `len` more characters and the null character.
+///
+/// @param sb string builder
+/// @param len number of characters to be added
+/// @return pointer to the end of the string, where `len` characters can be
+/// written before adding them with strbuf_commit(), or NULL if allocation
+/// failed
+char *strbuf_reserve(struct strbuf *sb, size_t len);
+
+/// @brief Add `len` characters written after strbuf_reserve() to the string.
+///
+/// @param sb string builder
+/// @param len number of characters written
+void strbuf_commit(struct strbuf *sb, size_t len);
+
+/// @brief Append `len` characters of `str`.
+///
+/// @param sb string builder
+/// @param str characters to append
+/// @param len number of characters
+/// @return 0 on success, EOF if allocation failed
+int strbuf_append(struct strbuf *restrict sb, const char *restrict str,
+                  size_t len);
+
+/// @brief Append formatted output, see printf().
+///
+/// @param sb string builder
+/// @param format format string
+/// @param ... arguments to print
+/// @return number of characters appended, or EOF if allocation failed or
+/// format is invalid, in which case the string is unchanged
+int strbuf_printf(struct strbuf *restrict sb, const char *restrict format,
+                  ...) __attribute__((__format__(__printf__, 2, 3)));
+
+/// @brief Append formatted output, see strbuf_printf() and vsnprintf().
+///
+/// @param sb string builder
+/// @param format format string
+/// @param arg input arguments
+/// @return number of characters appended, or EOF on error
+int strbuf_vprintf(struct strbuf *restrict sb, const char *restrict format,
+                   va_list arg);
+
+/// @brief Release the buffer and reset the builder to empty.
+///
+/// @param sb string builder
+void strbuf_free(struct strbuf *sb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_STRBUF_H */
@@ -76,6 +76,85 @@ void *memcpy(void *restrict dest, const void *restrict src, size_t len)
 void *memmove(void *dest, const void *src, size_t len)
     __attribute__((nonnull(1, 2)));
 
+/// @brief Copy memory and return end of copy.
+///
+/// The mempcpy function is like memcpy, but returns pointer past the last
+/// written character, so consecutive copies don't have to track offsets.
+/// @param dest address of destination
+/// @param src address of source object
+/// @param len length in characters (bytes)
+/// @return `dest` + `len`
+void *mempcpy(void *restrict dest, const void *restrict src, size_t len)
+    __attribute__((nonnull(1, 2)));
+
+/// @brief Copy memory up to character.
+///
+/// The memccpy function copies characters from the object pointed to by `src`
+/// into the object pointed to by `dest`, stopping after the first occurrence
+/// of `c` (converted to an unsigned char) is copied, or after `len` characters
+/// are copied, whichever comes first.
+/// @param dest address of destination
+/// @param src address of source object
+/// @param c character to stop at
+/// @param len maximum number of characters to copy
+/// @return pointer to the character after the copy of `c` in `dest`, or a null
+/// pointer if `c` was not found in the first `len` characters of `src`.
+void *memccpy(void *restrict dest, const void *restrict src, int c, size_t len)
+    __attribute__((nonnull(1, 2)));
+
+/// @brief Fragment of memory for memcpy_gather and memcpy_scatter.
+struct mem_iovec {
+    void *iov_base;  ///< start of the fragment
+    size_t iov_len;  ///< length of the fragment in bytes
+};
+
+/// @brief Copy rectangular region.
+///
+/// The memcpy2d function copies `height` rows of `width` characters each. Rows
+/// start `src_pitch` characters apart in the source and `dest_pitch`
+/// characters apart in the destination, e.g. to copy a sub-region of a
+/// framebuffer. If copying takes place between objects that overlap, the
+/// behavior is undefined.
+/// @param dest address of the first destination row
+/// @param dest_pitch distance between destination rows in bytes
+/// @param src address of the first source row
+/// @param src_pitch distance between source rows in bytes
+/// @param width length of row in bytes
+/// @param height number of rows
+/// @return value of `dest`
+void *memcpy2d(void *restrict dest, size_t dest_pitch,
+               const void *restrict src, size_t src_pitch, size_t width,
+               size_t height) __attribute__((nonnull(1, 3)));
+
+/// @brief Copy list of fragments into contiguous memory.
+///
+/// The memcpy_gather function copies fragments described by `iovcnt` elements
+/// of `iov` one after another into the object pointed to by `dest`, but not
+/// more than `len` characters in total.
+/// @param dest address of destination
+/// @param len capacity of destination in bytes
+/// @param iov array of fragments to copy
+/// @param iovcnt number of elements in `iov`
+/// @return number of characters copied
+size_t memcpy_gather(void *restrict dest, size_t len,
+                     const struct mem_iovec *iov, size_t iovcnt)
+    __attribute__((nonnull(1)));
+
+/// @brief Copy contiguous memory into list of fragments.
+///
+/// The memcpy_scatter function copies `len` characters from the object pointed
+/// to by `src` into fragments described by `iovcnt` elements of `iov`, filling
+/// each one before moving to the next one.
+/// @param iov array of destination fragments
+/// @param iovcnt number of elements in `iov`
+/// @param src address of source object
+/// @param len number of characters to copy
+/// @return number of characters copied, less than `len` if fragments are too
+/// small
+size_t memcpy_scatter(const struct mem_iovec *iov, size_t iovcnt,
+                      const void *restrict src, size_t len)
+    __attribute__((nonnull(3)));
+
 /// @brief Copy string.
 ///
 ///  The strcpy function copies the string pointed to by `src` (including the
@@ -87,6 +166,29 @@ void *memmove(void *dest, const void *src, size_t len)
 char *strcpy(char *restrict dest, const char *restrict src)
     __attribute__((nonnull(1, 2)));
 
+/// @brief Copy string and return its end.
+///
+/// The stpcpy function is like strcpy, but returns pointer to the terminating
+/// null character in `dest`. Use it to append strings without rescanning the
+/// destination as strcat does.
+/// @param dest address of destination string
+/// @param src address of source string
+/// @return pointer to the terminating null character in `dest`.
+char *stpcpy(char *restrict dest, const char *restrict src)
+    __attribute__((nonnull(1, 2)));
+
+/// @brief Copy not more than `len` characters of string.
+///
+/// The strncpy function copies not more than `len` characters (characters that
+/// follow a null character are not copied) from the array pointed to by `src`
+/// to the array pointed to by `dest`. If `src` is shorter than `len`
+/// characters, null characters are appended until `len` characters in all have
+/// been written. Note that `dest` is not null-terminated if `src` is not
+/// shorter than `len`, see strzcpy.
+/// @param dest address of destination string
+/// @param src address of source string
+/// @param len number of characters to write
+/// @return value of `dest`.
 char *strncpy(char *restrict dest, const char *restrict src, size_t len);
 
 /// @brief Copy string with guaranteed zero termination.
@@ -99,7 +201,26 @@ char *strzcpy(char *restrict dest, const char *restrict src, size_t len);
 
 /// @}
 
+/// @brief Concatenate strings.
+///
+/// The strcat function appends a copy of the string pointed to by `s2`
+/// (including the terminating null character) to the end of the string pointed
+/// to by `s1`.
+/// @param s1 null-terminated string to append to
+/// @param s2 null-terminated string to append
+/// @return value of `s1`.
 char *strcat(char *restrict s1, const char *restrict s2);
+
+/// @brief Concatenate not more than `len` characters of string.
+///
+/// The strncat function appends not more than `len` characters (a null
+/// character and characters that follow it are not appended) from the array
+/// pointed to by `s2` to the end of the string pointed to by `s1`. A
+/// terminating null character is always appended to the result.
+/// @param s1 null-terminated string to append to
+/// @param s2 string to append
+/// @param len maximum number of characters to append
+/// @return value of `s1`.
 char *strncat(char *restrict s1, const char *restrict s2, size_t len);
 
 /// @defgroup g2 Compare memory or string functions.
@@ -117,6 +238,18 @@ char *strncat(char *restrict s1, const char *restrict s2, size_t len);
 /// equal to, or less than the object pointed to by s2.
 int memcmp(const void *s1, const void *s2, size_t len);
 
+/// @brief Check memory for equality.
+///
+/// The memeq function checks if the first `len` characters of the objects
+/// pointed to by `s1` and `s2` are equal. Unlike memcmp it doesn't locate the
+/// first mismatch, which makes it faster when ordering is not needed.
+/// @param s1 pointer to first memory object
+/// @param s2 pointer to second memory object
+/// @param len size of memory objects
+/// @return 1 if objects are equal, 0 otherwise
+int memeq(const void *s1, const void *s2, size_t len)
+    __attribute__((nonnull(1, 2)));
+
 /// @brief Compare null-terminated strings
 ///
 /// The strcmp function compares the string pointed to by `s1` to the string
@@ -175,6 +308,47 @@ const void *memchr(const void *buffer, int c, size_t n);
 
 const void *memrchr(const void *buffer, int c, size_t n);
 
+/// @brief Find first occurence of any of two characters.
+///
+/// The memchr2 function locates the first occurrence of either `c1` or `c2`
+/// (each converted to an unsigned char) in the initial `n` characters of the
+/// object pointed to by `buffer`, scanning it once.
+/// @param buffer source buffer
+/// @param c1 first character to search
+/// @param c2 second character to search
+/// @param n length of buffer
+/// @return pointer to the located character, or a null pointer if none of the
+/// characters occur in the object.
+const void *memchr2(const void *buffer, int c1, int c2, size_t n);
+
+/// @brief Find first occurence of any of three characters.
+///
+/// The memchr3 function locates the first occurrence of either `c1`, `c2` or
+/// `c3` (each converted to an unsigned char) in the initial `n` characters of
+/// the object pointed to by `buffer`, scanning it once.
+/// @param buffer source buffer
+/// @param c1 first character to search
+/// @param c2 second character to search
+/// @param c3 third character to search
+/// @param n length of buffer
+/// @return pointer to the located character, or a null pointer if none of the
+/// characters occur in the object.
+const void *memchr3(const void *buffer, int c1, int c2, int c3, size_t n);
+
+/// @brief Find first occurence of byte sequence.
+///
+/// The memmem function locates the first occurrence of the `nl` characters
+/// pointed to by `needle` in the initial `hl` characters of the object pointed
+/// to by `haystack`. Search takes linear time for any input.
+/// @param haystack object to search in
+/// @param hl length of haystack
+/// @param needle sequence to search for
+/// @param nl length of needle
+/// @return pointer to the located sequence, `haystack` if `nl` is zero, or a
+/// null pointer if the sequence does not occur in the object.
+const void *memmem(const void *haystack, size_t hl, const void *needle,
+                   size_t nl);
+
 /// @brief Find first occurence of character in null-terminated string.
 ///
 /// The strchr function locates the first occurrence of `c` (converted to a
@@ -206,10 +380,37 @@ size_t strcspn(const char *s, const char *characters);
 ///@return length of the maximum initial segment
 size_t strspn(const char *s, const char *characters);
 
+/// @brief Find first occurence of any character from the list.
+///
+/// The strpbrk function locates the first occurrence in the string pointed to
+/// by `s1` of any character from the string pointed to by `s2`.
+/// @param s1 pointer to the null-terminated byte string to be analyzed
+/// @param s2 pointer to the null-terminated byte string that contains the
+/// characters to search for
+/// @return pointer to the character in `s1`, or a null pointer if no character
+/// from `s2` occurs in `s1`.
 char *strpbrk(const char *s1, const char *s2);
 
+/// @brief Find last occurence of character in null-terminated string.
+///
+/// The strrchr function locates the last occurrence of `c` (converted to a
+/// char) in the string pointed to by `s`. The terminating null character is
+/// considered to be part of the string.
+/// @param s null-terminated string
+/// @param c character to search
+/// @return returns a pointer to the located character, or a null pointer if the
+/// character does not occur in the string.
 char *strrchr(const char *s, int c);
 
+/// @brief Find first occurence of substring.
+///
+/// The strstr function locates the first occurrence in the string pointed to by
+/// `s1` of the sequence of characters (excluding the terminating null
+/// character) in the string pointed to by `s2`.
+/// @param s1 null-terminated string to search in
+/// @param s2 null-terminated string to search for
+/// @return pointer to the located string, `s1` if `s2` is empty, or a null
+/// pointer if the string is not found.
 char *strstr(const char *s1, const char *s2);
 
 /// @}
@@ -239,6 +440,37 @@ void *memset(void *dest, int c, size_t len);
 /// @return value of `dest`
 void *memset_explicit(void *dest, int c, size_t len);
 
+/// @brief Fill memory with 16-bit value.
+///
+/// The memset16 function copies `value` into each of the first `count`
+/// 16-bit elements of the array pointed to by `dest`, e.g. to fill a RGB565
+/// framebuffer with a color.
+/// @param dest destination array, aligned to 2 bytes
+/// @param value value to fill in
+/// @param count number of elements to fill
+/// @return value of `dest`
+uint16_t *memset16(uint16_t *dest, uint16_t value, size_t count);
+
+/// @brief Fill memory with 32-bit value.
+///
+/// The memset32 function copies `value` into each of the first `count`
+/// 32-bit elements of the array pointed to by `dest`.
+/// @param dest destination array, aligned to 4 bytes
+/// @param value value to fill in
+/// @param count number of elements to fill
+/// @return value of `dest`
+uint32_t *memset32(uint32_t *dest, uint32_t value, size_t count);
+
+/// @brief Fill memory with 64-bit value.
+///
+/// The memset64 function copies `value` into each of the first `count`
+/// 64-bit elements of the array pointed to by `dest`.
+/// @param dest destination array, aligned to 8 bytes
+/// @param value value to fill in
+/// @param count number of elements to fill
+/// @return value of `dest`
+uint64_t *memset64(uint64_t *dest, uint64_t value, size_t count);
+
 /// @brief Compute length of the string with limit.
 ///
 /// The strlen function computes the length of the string pointed to by s.
@@ -288,6 +520,40 @@ static inline int toupper(int c) {
     return c >= 'a' && c <= 'z' ? c + 'A' - 'a' : c;
 }
 
+/// @defgroup g5 Inline memory operations.
+/// Define NOC_INLINE_MEMOPS before including <string.h> to expand memcpy and
+/// memset with small compile-time constant sizes into direct loads and stores,
+/// even when the compiler is invoked with -fno-builtin-memcpy. Calls with
+/// variable or large sizes still go to the library routines.
+/// @{
+#if defined(NOC_INLINE_MEMOPS)
+
+#ifndef NOC_INLINE_MEMOPS_MAX
+/// Largest constant size expanded inline
+#define NOC_INLINE_MEMOPS_MAX 64
+#endif
+
+static inline __attribute__((always_inline)) void *noc_memcpy_inline(
+    void *restrict dest, const void *restrict src, size_t len) {
+    if (__builtin_constant_p(len) && len <= NOC_INLINE_MEMOPS_MAX)
+        return __builtin_memcpy(dest, src, len);
+    return memcpy(dest, src, len);
+}
+
+static inline __attribute__((always_inline)) void *noc_memset_inline(
+    void *dest, int c, size_t len) {
+    if (__builtin_constant_p(len) && len <= NOC_INLINE_MEMOPS_MAX)
+        return __builtin_memset(dest, c, len);
+    return memset(dest, c, len);
+}
+
+// Use (memcpy)(...) to call the library routine explicitly
+#define memcpy(dest, src, len) noc_memcpy_inline(dest, src, len)
+#define memset(dest, c, len) noc_memset_inline(dest, c, len)
+
+#endif  // NOC_INLINE_MEMOPS
+/// @}
+
 #ifdef __cplusplus
 }
 #endif
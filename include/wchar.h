@@ -0,0 +1,58 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+/// @file wchar.h
+/// @brief Wide character array functions. Subset of `wchar.h` from C standard
+/// library.
+
+#ifndef NOC_WCHAR_H
+#define NOC_WCHAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Copy wide characters.
+///
+/// The wmemcpy function copies `n` wide characters from the object pointed to
+/// by `src` to the object pointed to by `dest`. If copying takes place between
+/// objects that overlap, the behavior is undefined.
+/// @param dest address of destination
+/// @param src address of source object
+/// @param n number of wide characters
+/// @return value of `dest`
+wchar_t *wmemcpy(wchar_t *restrict dest, const wchar_t *restrict src,
+                 size_t n);
+
+/// @brief Move wide characters.
+///
+/// The wmemmove function copies `n` wide characters from the object pointed to
+/// by `src` to the object pointed to by `dest`. Copying takes place as if
+/// through a temporary array, so objects may overlap.
+/// @param dest address of destination
+/// @param src address of source object
+/// @param n number of wide characters
+/// @return value of `dest`
+wchar_t *wmemmove(wchar_t *dest, const wchar_t *src, size_t n);
+
+/// @brief Fill wide characters.
+///
+/// The wmemset function copies the value of `c` into each of the first `n`
+/// wide characters of the object pointed to by `dest`.
+/// @param dest address of destination
+/// @param c wide character to fill in
+/// @param n number of wide characters
+/// @return value of `dest`
+wchar_t *wmemset(wchar_t *dest, wchar_t c, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOC_WCHAR_H */
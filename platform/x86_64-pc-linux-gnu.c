@@ -8,6 +8,7 @@
 #include <linux/time_types.h>
 #include <sched.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
@@ -90,7 +91,12 @@ intptr_t putnstr(const char *str, size_t len) {
     return __syscall3(SYS_write, 1, (uintptr_t)str, len);
 }
 
-void exit(int ret) { __syscall1(SYS_exit, ret); }
+// Buffered standard output is written out before the process ends. User
+// streams are not tracked and are flushed by their owners.
+void exit(int ret) {
+    fflush(NULL);
+    __syscall1(SYS_exit, ret);
+}
 
 // _brk_start, _brk_end comes from linker script
 extern char _brk_start[];
@@ -107,11 +113,12 @@ void *sbrk(intptr_t incr) {
     intptr_t new_brk = brk_off + incr;
 
     if ((new_brk <= (intptr_t)_brk_end) && (new_brk >= (intptr_t)_brk_start)) {
+        const intptr_t old_brk = brk_off;
         brk_off = new_brk;
 #ifdef VERBOSE_SBRK
         printf("sbrk(%zd) new brk at %p\n", incr, (void *)brk_off);
 #endif
-        return (void *)brk_off;
+        return (void *)old_brk;
     }
 #ifdef VERBOSE_SBRK
     printf("sbrk(%zd) failed, brk at %p\n", incr, (void *)brk_off);
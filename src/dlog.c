@@ -0,0 +1,140 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <dlog.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "noc_internal/common.h"
+
+STATIC_ASSERT((DLOG_BUFFER_SIZE & (DLOG_BUFFER_SIZE - 1)) == 0);
+STATIC_ASSERT(DLOG_BUFFER_SIZE >= DLOG_MAX_RECORD);
+STATIC_ASSERT(DLOG_MAX_RECORD % 4 == 0 && DLOG_MAX_RECORD <= 0xfffc);
+
+// Ring buffer of records. `head` is advanced by the writer, `tail` by the
+// reader, both are free running byte counters. Records are multiples of 4
+// bytes, so the header word is never split by the wrap around.
+static struct {
+    uint8_t buf[DLOG_BUFFER_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+} ring;
+
+static inline uint32_t load(const uint32_t *p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+// Copy `len` bytes to ring position `pos`
+static void ring_put(uint32_t pos, const void *src, size_t len) {
+    const size_t off = pos % DLOG_BUFFER_SIZE;
+    const size_t n = MIN(len, DLOG_BUFFER_SIZE - off);
+    memcpy(ring.buf + off, src, n);
+    memcpy(ring.buf, (const uint8_t *)src + n, len - n);
+}
+
+// Copy `len` bytes from ring position `pos`
+static void ring_get(uint32_t pos, void *dest, size_t len) {
+    const size_t off = pos % DLOG_BUFFER_SIZE;
+    const size_t n = MIN(len, DLOG_BUFFER_SIZE - off);
+    memcpy(dest, ring.buf + off, n);
+    memcpy((uint8_t *)dest + n, ring.buf, len - n);
+}
+
+int dlog(const char *format, ...) {
+    uint32_t rec[DLOG_MAX_RECORD / sizeof(uint32_t)];
+    va_list args;
+
+    va_start(args, format);
+    const intptr_t size = dlog_encode(rec, sizeof(rec), format, args);
+    va_end(args);
+
+    const uint32_t head = ring.head;
+    if (size < 0 ||
+        DLOG_BUFFER_SIZE - (head - load(&ring.tail)) < (uint32_t)size) {
+        __atomic_fetch_add(&ring.dropped, 1, __ATOMIC_RELAXED);
+        return EOF;
+    }
+    ring_put(head, rec, (size_t)size);
+    __atomic_store_n(&ring.head, head + (uint32_t)size, __ATOMIC_RELEASE);
+    return 0;
+}
+
+size_t dlog_read(void *dest, size_t len) {
+    const uint32_t head = load(&ring.head);
+    uint32_t tail = ring.tail;
+    size_t n = 0;
+
+    while (tail != head) {
+        uint32_t header;
+        ring_get(tail, &header, sizeof(header));
+        const size_t size = header & 0xffff;
+        if (size > len - n) break;
+        ring_get(tail, (uint8_t *)dest + n, size);
+        tail += (uint32_t)size;
+        n += size;
+    }
+    __atomic_store_n(&ring.tail, tail, __ATOMIC_RELEASE);
+    return n;
+}
+
+uint32_t dlog_dropped(void) {
+    return __atomic_exchange_n(&ring.dropped, 0, __ATOMIC_RELAXED);
+}
+
+size_t dlog_next(const void *data, size_t len, struct dlog_record *rec) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t header;
+
+    if (len < sizeof(header)) return 0;
+    memcpy(&header, p, sizeof(header));
+    const size_t size = header & 0xffff, addr_size = (header >> 16) & 0xff;
+    if (size > len || size < sizeof(header) + addr_size) return 0;
+
+    if (addr_size == sizeof(uint64_t)) {
+        memcpy(&rec->format, p + sizeof(header), sizeof(uint64_t));
+    } else if (addr_size == sizeof(uint32_t)) {
+        uint32_t addr;
+        memcpy(&addr, p + sizeof(header), sizeof(addr));
+        rec->format = addr;
+    } else {
+        return 0;
+    }
+    rec->args = p + sizeof(header) + addr_size;
+    rec->args_len = size - sizeof(header) - addr_size;
+    return size;
+}
+
+int dlog_flush(void) {
+    uint32_t buf[DLOG_MAX_RECORD / sizeof(uint32_t)];
+    int count = 0;
+    size_t len;
+
+    while ((len = dlog_read(buf, sizeof(buf))) > 0) {
+        struct dlog_record rec;
+        const uint8_t *p = (const uint8_t *)buf;
+        for (size_t size; (size = dlog_next(p, len, &rec)) > 0;) {
+            const int res =
+                dlog_printf((const char *)(uintptr_t)rec.format, &rec);
+            if (res < 0) return EOF;
+            count += res;
+            p += size;
+            len -= size;
+        }
+    }
+
+    const uint32_t dropped = dlog_dropped();
+    if (dropped) {
+        const int res = printf("[dlog: %u records dropped]\n", dropped);
+        if (res < 0) return EOF;
+        count += res;
+    }
+    return count;
+}
@@ -0,0 +1,249 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <encoding.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "noc_internal/common.h"
+
+#if defined(ARCH_X86_64) && defined(__SSSE3__)
+#include <immintrin.h>
+#define ENCODING_SSSE3 1
+#endif
+
+static const char hex_digits[17] = "0123456789abcdef";
+
+static const char base64_chars[65] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Values of characters plus 1, 0 for invalid characters
+static const uint8_t hex_value[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7,
+    ['7'] = 8, ['8'] = 9, ['9'] = 10, ['a'] = 11, ['b'] = 12, ['c'] = 13,
+    ['d'] = 14, ['e'] = 15, ['f'] = 16, ['A'] = 11, ['B'] = 12, ['C'] = 13,
+    ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+static const uint8_t base64_value[256] = {
+    ['A'] = 1, ['B'] = 2, ['C'] = 3, ['D'] = 4, ['E'] = 5, ['F'] = 6, ['G'] = 7,
+    ['H'] = 8, ['I'] = 9, ['J'] = 10, ['K'] = 11, ['L'] = 12, ['M'] = 13,
+    ['N'] = 14, ['O'] = 15, ['P'] = 16, ['Q'] = 17, ['R'] = 18, ['S'] = 19,
+    ['T'] = 20, ['U'] = 21, ['V'] = 22, ['W'] = 23, ['X'] = 24, ['Y'] = 25,
+    ['Z'] = 26, ['a'] = 27, ['b'] = 28, ['c'] = 29, ['d'] = 30, ['e'] = 31,
+    ['f'] = 32, ['g'] = 33, ['h'] = 34, ['i'] = 35, ['j'] = 36, ['k'] = 37,
+    ['l'] = 38, ['m'] = 39, ['n'] = 40, ['o'] = 41, ['p'] = 42, ['q'] = 43,
+    ['r'] = 44, ['s'] = 45, ['t'] = 46, ['u'] = 47, ['v'] = 48, ['w'] = 49,
+    ['x'] = 50, ['y'] = 51, ['z'] = 52, ['0'] = 53, ['1'] = 54, ['2'] = 55,
+    ['3'] = 56, ['4'] = 57, ['5'] = 58, ['6'] = 59, ['7'] = 60, ['8'] = 61,
+    ['9'] = 62, ['+'] = 63, ['/'] = 64,
+};
+
+#if defined(ENCODING_SSSE3)
+// Values of hexadecimal digits, with bit 7 set for invalid characters
+static inline __attribute__((always_inline)) __m128i hex_values(
+    __m128i c) {
+    const __m128i dig = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i let = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)),
+                                     _mm_set1_epi8('a'));
+    // Unsigned x <= n is min(x, n) == x
+    const __m128i is_dig =
+        _mm_cmpeq_epi8(_mm_min_epu8(dig, _mm_set1_epi8(9)), dig);
+    const __m128i is_let =
+        _mm_cmpeq_epi8(_mm_min_epu8(let, _mm_set1_epi8(5)), let);
+    const __m128i v = _mm_or_si128(
+        _mm_and_si128(is_dig, dig),
+        _mm_and_si128(is_let, _mm_add_epi8(let, _mm_set1_epi8(10))));
+    return _mm_or_si128(v, _mm_andnot_si128(_mm_or_si128(is_dig, is_let),
+                                            _mm_set1_epi8((char)0x80)));
+}
+
+// Split 12 bytes into 16 6-bit indices, one per byte. Bytes are arranged as
+// [b1 b0 b2 b1] per 32-bit lane, so each index is moved in place with a
+// multiplication by a power of 2.
+static inline __m128i base64_split(__m128i v) {
+    v = _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7,
+                                          10, 9, 11, 10));
+    const __m128i t0 =
+        _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                        _mm_set1_epi32(0x04000040));
+    const __m128i t1 =
+        _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                        _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+// Translate 6-bit indices to characters by adding an offset per range:
+// A-Z, a-z, 0-9, '+' and '/'
+static inline __m128i base64_chars_vec(__m128i v) {
+    const __m128i offset = _mm_setr_epi8('A', 'a' - 26, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '+' - 62, '/' - 63, 0, 0);
+    // 0 for A-Z, 1 for a-z, 2..11 for digits, 12 for '+', 13 for '/'
+    __m128i range = _mm_subs_epu8(v, _mm_set1_epi8(51));
+    range = _mm_sub_epi8(range, _mm_cmpgt_epi8(v, _mm_set1_epi8(25)));
+    return _mm_add_epi8(v, _mm_shuffle_epi8(offset, range));
+}
+
+// Translate characters to 6-bit values in place. Invalid characters are
+// looked up by low and high nibble as bit sets, a character is invalid if the
+// sets intersect. Returns false if there are invalid characters.
+static inline bool base64_values(__m128i *c) {
+    const __m128i lut_lo =
+        _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                      0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi =
+        _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll =
+        _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nib = _mm_set1_epi8(0x0f);
+    const __m128i hi_nib = _mm_and_si128(_mm_srli_epi32(*c, 4), nib);
+    const __m128i lo_nib = _mm_and_si128(*c, nib);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nib);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nib);
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi),
+                                         _mm_setzero_si128())) != 0xffff)
+        return false;
+    // '/' shares the high nibble with '+', but needs a different offset
+    const __m128i is_slash = _mm_cmpeq_epi8(*c, _mm_set1_epi8('/'));
+    *c = _mm_add_epi8(
+        *c, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(is_slash, hi_nib)));
+    return true;
+}
+
+// Pack 16 6-bit values into 12 bytes, in the low part of the vector
+static inline __m128i base64_pack(__m128i v) {
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                             13, 12, -1, -1, -1, -1));
+}
+#endif
+
+size_t hex_encode(char *restrict dest, const void *restrict src, size_t len) {
+    const uint8_t *s = (const uint8_t *)src;
+    char *d = dest;
+
+#if defined(ENCODING_SSSE3)
+    const __m128i digits = _mm_loadu_si128((const __m128i *)hex_digits);
+    const __m128i nib = _mm_set1_epi8(0x0f);
+    for (; len >= 16; len -= 16, s += 16, d += 32) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)s);
+        const __m128i hi = _mm_shuffle_epi8(
+            digits, _mm_and_si128(_mm_srli_epi16(v, 4), nib));
+        const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, nib));
+        _mm_storeu_si128((__m128i *)d, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(d + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+    for (; len; len--, s++) {
+        *d++ = hex_digits[*s >> 4];
+        *d++ = hex_digits[*s & 0xf];
+    }
+    return (size_t)(d - dest);
+}
+
+intptr_t hex_decode(void *restrict dest, const char *restrict src, size_t len) {
+    const uint8_t *s = (const uint8_t *)src;
+    uint8_t *d = (uint8_t *)dest;
+
+    if (len & 1) return -1;
+#if defined(ENCODING_SSSE3)
+    // Pairs of digits are combined as hi * 16 + lo
+    const __m128i weight = _mm_set1_epi16(0x0110);
+    for (; len >= 32; len -= 32, s += 32, d += 16) {
+        const __m128i a = hex_values(_mm_loadu_si128((const __m128i *)s));
+        const __m128i b =
+            hex_values(_mm_loadu_si128((const __m128i *)(s + 16)));
+        if (_mm_movemask_epi8(_mm_or_si128(a, b))) return -1;
+        _mm_storeu_si128((__m128i *)d,
+                         _mm_packus_epi16(_mm_maddubs_epi16(a, weight),
+                                          _mm_maddubs_epi16(b, weight)));
+    }
+#endif
+    for (; len; len -= 2, s += 2) {
+        const uint8_t hi = hex_value[s[0]], lo = hex_value[s[1]];
+        if (!hi || !lo) return -1;
+        *d++ = (uint8_t)((hi - 1) << 4 | (lo - 1));
+    }
+    return d - (uint8_t *)dest;
+}
+
+size_t base64_encode(char *restrict dest, const void *restrict src,
+                     size_t len) {
+    const uint8_t *s = (const uint8_t *)src;
+    char *d = dest;
+
+#if defined(ENCODING_SSSE3)
+    // Consume 12 bytes per iteration, but load 16
+    for (; len >= 16; len -= 12, s += 12, d += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)s);
+        _mm_storeu_si128((__m128i *)d, base64_chars_vec(base64_split(v)));
+    }
+#endif
+    for (; len >= 3; len -= 3, s += 3, d += 4) {
+        const uint32_t w = (uint32_t)s[0] << 16 | (uint32_t)s[1] << 8 | s[2];
+        d[0] = base64_chars[w >> 18];
+        d[1] = base64_chars[(w >> 12) & 63];
+        d[2] = base64_chars[(w >> 6) & 63];
+        d[3] = base64_chars[w & 63];
+    }
+    if (len) {
+        const uint32_t w =
+            (uint32_t)s[0] << 16 | (len > 1 ? (uint32_t)s[1] << 8 : 0);
+        d[0] = base64_chars[w >> 18];
+        d[1] = base64_chars[(w >> 12) & 63];
+        d[2] = (len > 1) ? base64_chars[(w >> 6) & 63] : '=';
+        d[3] = '=';
+        d += 4;
+    }
+    return (size_t)(d - dest);
+}
+
+intptr_t base64_decode(void *restrict dest, const char *restrict src,
+                       size_t len) {
+    const uint8_t *s = (const uint8_t *)src;
+    uint8_t *d = (uint8_t *)dest;
+
+    // Strip padding of a complete group
+    if (len && !(len % 4) && s[len - 1] == '=') {
+        len--;
+        if (s[len - 1] == '=') len--;
+    }
+    if (len % 4 == 1) return -1;
+#if defined(ENCODING_SSSE3)
+    // Produce 12 bytes per iteration, but store 16. At least 8 characters
+    // follow, which decode into at least 6 bytes.
+    for (; len >= 24; len -= 16, s += 16, d += 12) {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        if (!base64_values(&v)) return -1;
+        _mm_storeu_si128((__m128i *)d, base64_pack(v));
+    }
+#endif
+    for (; len >= 4; len -= 4, s += 4, d += 3) {
+        const uint32_t a = base64_value[s[0]], b = base64_value[s[1]],
+                       c = base64_value[s[2]], e = base64_value[s[3]];
+        if (!a || !b || !c || !e) return -1;
+        const uint32_t w =
+            (a - 1) << 18 | (b - 1) << 12 | (c - 1) << 6 | (e - 1);
+        d[0] = (uint8_t)(w >> 16);
+        d[1] = (uint8_t)(w >> 8);
+        d[2] = (uint8_t)w;
+    }
+    if (len) {
+        const uint32_t a = base64_value[s[0]], b = base64_value[s[1]],
+                       c = (len > 2) ? base64_value[s[2]] : 1;
+        if (!a || !b || !c) return -1;
+        const uint32_t w = (a - 1) << 18 | (b - 1) << 12 | (c - 1) << 6;
+        *d++ = (uint8_t)(w >> 16);
+        if (len > 2) *d++ = (uint8_t)(w >> 8);
+    }
+    return d - (uint8_t *)dest;
+}
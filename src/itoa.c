@@ -0,0 +1,76 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "noc_internal/common.h"
+
+// Pairs of decimal digits "00" to "99"
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint32_t pow10[10] = {1,         10,        100,     1000,
+                                   10000,     100000,    1000000, 10000000,
+                                   100000000, 1000000000};
+
+// Number of decimal digits in `x`: log10 estimated from the bit length as
+// log2 * 1233 / 4096, then corrected by a single comparison. Setting bit 0
+// counts 0 as one digit and never crosses a power of 10.
+static inline uint32_t dec_len(uint32_t x) {
+    x |= 1;
+    const uint32_t t = ((32 - stdc_leading_zerosui(x)) * 1233) >> 12;
+    return t + 1 - (x < pow10[t]);
+}
+
+// Quotient of x / 100 for any 32-bit x, by multiplication with reciprocal
+static inline uint32_t div100(uint32_t x) {
+    return (uint32_t)(((uint64_t)x * 0x51eb851f) >> 37);
+}
+
+// Write `len` digits of `x` ending at `end`, two at a time, leading zeroes
+// included
+static inline void put_digits(char *end, uint32_t x, uint32_t len) {
+    for (; len >= 2; len -= 2) {
+        const uint32_t q = div100(x);
+        end -= 2;
+        __builtin_memcpy(end, &digit_pairs[2 * (x - q * 100)], 2);
+        x = q;
+    }
+    if (len) *(--end) = (char)('0' + x);
+}
+
+char *u64toa(uint64_t value, char *str) {
+    uint32_t part[2];
+    size_t n = 0;
+
+    // Split off parts of 8 digits until the rest fits 32 bits, these are the
+    // only 64-bit divisions
+    while (value > UINT32_MAX) part[n++] = umoddiv32(&value, 100000000);
+
+    const uint32_t len = dec_len((uint32_t)value);
+    put_digits(str + len, (uint32_t)value, len);
+    str += len;
+    while (n) {
+        put_digits(str + 8, part[--n], 8);
+        str += 8;
+    }
+    *str = 0;
+    return str;
+}
+
+char *i64toa(int64_t value, char *str) {
+    uint64_t v = (uint64_t)value;
+    if (value < 0) {
+        *str++ = '-';
+        v = -v;
+    }
+    return u64toa(v, str);
+}
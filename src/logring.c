@@ -0,0 +1,149 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <logring.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+
+STATIC_ASSERT((LOGRING_SIZE & (LOGRING_SIZE - 1)) == 0);
+STATIC_ASSERT(LOGRING_SIZE <= 4 * 0x8000);
+STATIC_ASSERT(LOGRING_MAX_RECORD % 4 == 0 &&
+              LOGRING_MAX_RECORD <= LOGRING_SIZE / 2);
+STATIC_ASSERT(LOGRING_BATCH >= LOGRING_MAX_RECORD);
+
+// Record header: length of text in bits 0-15, size of record in 4-byte words
+// in bits 16-30, and the commit flag. Padding records with no text fill the
+// end of the ring, so each record is contiguous.
+#define HEADER_SIZE sizeof(uint32_t)
+#define COMMITTED (1U << 31)
+
+static inline uint32_t header(uint32_t size, size_t len) {
+    return (size / 4) << 16 | (uint32_t)len;
+}
+
+// Ring of records: `head` is advanced by producers reserving space, `tail`
+// by the consumer, both are free running byte counters. Free space is kept
+// zeroed, so a header in reserved space reads as not committed until the
+// producer commits it.
+static struct {
+    uint32_t buf[LOGRING_SIZE / 4];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+} ring;
+
+static inline uint32_t *slot(uint32_t pos) {
+    return &ring.buf[(pos % LOGRING_SIZE) / 4];
+}
+
+static inline uint32_t align4(size_t len) {
+    return (uint32_t)(len + 3) & ~3U;
+}
+
+char *logring_reserve(size_t len, uint32_t *ticket) {
+    const uint32_t size = align4(HEADER_SIZE + len);
+    uint32_t h = __atomic_load_n(&ring.head, __ATOMIC_RELAXED), pad;
+
+    if (size > LOGRING_MAX_RECORD) return NULL;
+    do {
+        const uint32_t off = h % LOGRING_SIZE;
+        pad = (off + size > LOGRING_SIZE) ? LOGRING_SIZE - off : 0;
+        if (h + pad + size - __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE) >
+            LOGRING_SIZE) {
+            __atomic_fetch_add(&ring.dropped, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&ring.head, &h, h + pad + size, true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    if (pad)
+        __atomic_store_n(slot(h), COMMITTED | header(pad, 0),
+                         __ATOMIC_RELEASE);
+    *ticket = h + pad;
+    // Reserved size, for the commit
+    __atomic_store_n(slot(*ticket), header(size, 0), __ATOMIC_RELAXED);
+    return (char *)(slot(*ticket) + 1);
+}
+
+void logring_commit(uint32_t ticket, size_t len) {
+    uint32_t *hdr = slot(ticket);
+    uint32_t size = ((*hdr >> 16) & 0x7fff) * 4;
+    len = MIN(len, size - HEADER_SIZE);
+    const uint32_t used = align4(HEADER_SIZE + len);
+
+    // Give unused space back if the record is still the last one
+    uint32_t end = ticket + size;
+    if (used < size &&
+        __atomic_compare_exchange_n(&ring.head, &end, ticket + used, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        size = used;
+    __atomic_store_n(hdr, COMMITTED | header(size, len), __ATOMIC_RELEASE);
+}
+
+int logring_vprintf(const char *format, va_list args) {
+    const size_t max = LOGRING_MAX_RECORD - HEADER_SIZE;
+    uint32_t ticket;
+    char *text = logring_reserve(max, &ticket);
+
+    if (!text) return EOF;
+    // Formatted in place, the terminating null is not kept
+    const int res = vsnprintf(text, max, format, args);
+    logring_commit(ticket, (res < 0) ? 0 : MIN((size_t)res, max - 1));
+    return (res < 0) ? EOF : (int)MIN((size_t)res, max - 1);
+}
+
+int logring_printf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    const int res = logring_vprintf(format, args);
+    va_end(args);
+    return res;
+}
+
+size_t logring_read(char *dest, size_t len) {
+    const uint32_t head = __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE);
+    uint32_t tail = ring.tail;
+    size_t n = 0;
+
+    while (tail != head) {
+        uint32_t *hdr = slot(tail);
+        const uint32_t h = __atomic_load_n(hdr, __ATOMIC_ACQUIRE);
+        if (!(h & COMMITTED)) break;
+        const size_t text = h & 0xffff, size = ((h >> 16) & 0x7fff) * 4;
+        if (text > len - n) break;
+        memcpy(dest + n, hdr + 1, text);
+        n += text;
+        // Keep free space zeroed for the next headers
+        memset(hdr, 0, size);
+        tail += (uint32_t)size;
+    }
+    __atomic_store_n(&ring.tail, tail, __ATOMIC_RELEASE);
+    return n;
+}
+
+size_t logring_drain(void) {
+    char batch[LOGRING_BATCH];
+    size_t total = 0, n;
+
+    // Keep order with buffered printf() output
+    fflush(stdout);
+    while ((n = logring_read(batch, sizeof(batch))) > 0) {
+        putnstr(batch, n);
+        total += n;
+    }
+    return total;
+}
+
+uint32_t logring_dropped(void) {
+    return __atomic_exchange_n(&ring.dropped, 0, __ATOMIC_RELAXED);
+}
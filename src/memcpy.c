@@ -9,6 +9,11 @@
 #include <string.h>
 
 #include "noc_internal/common.h"
+#include "noc_internal/simd.h"
+
+// Library routines are defined here, not the inline wrappers
+#undef memcpy
+#undef memset
 
 #if defined(ARCH_X86_64)
 void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
@@ -17,20 +22,44 @@ void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
     __asm__ volatile ("rep movsb\n" : "+D"(dest), "+S"(src), "+c"(len) : : "memory");
     return dest_copy;
 }
-#else
+#endif
 
-void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
-    uint8_t *d = (uint8_t *)dest;
-    const uint8_t *s = (const uint8_t *)src;
+#if defined(NOC_SIMD)
+#ifndef MEMCPY_MOVSB_THRESHOLD
+// Copies of at least this size in copy_fwd() use `rep movsb`, below it the
+// startup cost of fast strings is higher than a vector loop.
+#define MEMCPY_MOVSB_THRESHOLD 1024
+#endif
+
+// Forward copy kernel for callers copying many rows or fragments, without
+// going through memcpy() for each of them.
+static inline __attribute__((always_inline)) void copy_fwd(
+    uint8_t *restrict d, const uint8_t *restrict s, size_t len) {
+    if (len <= 2 * VEC_SIZE) {
+        vec_move_short(d, s, len);
+    } else if (len >= MEMCPY_MOVSB_THRESHOLD) {
+        __asm__ volatile("rep movsb\n"
+                         : "+D"(d), "+S"(s), "+c"(len)
+                         :
+                         : "memory");
+    } else {
+        // Last vector may overlap with the loop
+        const vec_t tail = vec_loadu(s + len - VEC_SIZE);
+        for (size_t i = 0; i < len - VEC_SIZE; i += VEC_SIZE)
+            vec_storeu(d + i, vec_loadu(s + i));
+        vec_storeu(d + len - VEC_SIZE, tail);
+    }
+}
+#else
+static inline __attribute__((always_inline)) void copy_fwd(
+    uint8_t *restrict d, const uint8_t *restrict s, size_t len) {
     uintptr_t *dw;
     const uintptr_t *sw;
     const uintptr_t mask = sizeof(*dw) - 1;
 
-    uint8_t *const tail = (uint8_t *)dest + len;
+    uint8_t *const tail = d + len;
     uint8_t *head = tail;
 
-    if (dest == src || len == 0) return dest;
-
     // Set 'body' to the last word boundary
     uintptr_t *const body = (uintptr_t *)((uintptr_t)tail & ~mask);
     // If equally aligned and long enough
@@ -49,10 +78,57 @@ void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
     d = (uint8_t *)dw;
     s = (const uint8_t *)sw;
     while (d < tail) *(d++) = *(s++);
+}
+#endif
+
+#if !defined(ARCH_X86_64)
+void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
+    if (dest == src || len == 0) return dest;
+    copy_fwd((uint8_t *)dest, (const uint8_t *)src, len);
     return dest;
 }
 #endif
 
+void *memcpy2d(void *restrict dest, size_t dest_pitch,
+               const void *restrict src, size_t src_pitch, size_t width,
+               size_t height) {
+    uint8_t *d = (uint8_t *)dest;
+    const uint8_t *s = (const uint8_t *)src;
+
+    // Contiguous rows are a single copy
+    if (dest_pitch == width && src_pitch == width) {
+        width *= height;
+        height = 1;
+    }
+    for (; height; height--, d += dest_pitch, s += src_pitch)
+        copy_fwd(d, s, width);
+    return dest;
+}
+
+size_t memcpy_gather(void *restrict dest, size_t len,
+                     const struct mem_iovec *iov, size_t iovcnt) {
+    uint8_t *d = (uint8_t *)dest;
+    for (; iovcnt && len; iov++, iovcnt--) {
+        const size_t n = MIN(iov->iov_len, len);
+        copy_fwd(d, (const uint8_t *)iov->iov_base, n);
+        d += n;
+        len -= n;
+    }
+    return (size_t)(d - (uint8_t *)dest);
+}
+
+size_t memcpy_scatter(const struct mem_iovec *iov, size_t iovcnt,
+                      const void *restrict src, size_t len) {
+    const uint8_t *s = (const uint8_t *)src;
+    for (; iovcnt && len; iov++, iovcnt--) {
+        const size_t n = MIN(iov->iov_len, len);
+        copy_fwd((uint8_t *)iov->iov_base, s, n);
+        s += n;
+        len -= n;
+    }
+    return (size_t)(s - (const uint8_t *)src);
+}
+
 // TODO: reconsider where check function should go
 // https://refspecs.linuxbase.org/LSB_5.0.0/LSB-Core-generic/LSB-Core-generic/libc-ddefs.html
 __attribute__((weak)) void __chk_fail(void) { __builtin_trap(); }
@@ -100,26 +176,197 @@ void *__memset_chk(void *dest, int c, size_t len, size_t destlen) {
     return memset(dest, c, len);
 }
 
-void *memmove(void *dest, const void *src, size_t len) {
-    if ((uintptr_t)dest <= (uintptr_t)src ||
-        (uintptr_t)dest >= (uintptr_t)src + len) {
-        // No overlap, so just use memcpy().
-        return memcpy(dest, src, len);
+// Store one element of `size` bytes from the pattern
+static inline void store_elem(uint8_t *d, uint64_t pattern, size_t size) {
+    if (size == 8)
+        __builtin_memcpy(d, &pattern, 8);
+    else if (size == 4)
+        __builtin_memcpy(d, &pattern, 4);
+    else
+        __builtin_memcpy(d, &pattern, 2);
+}
+
+// Fill `len` bytes with `pattern` of repeated elements of `size` bytes. Both
+// `d` and `len` are multiples of `size`, so any aligned word or vector store
+// is in phase with the elements.
+#if defined(NOC_SIMD)
+static void fill_pattern(uint8_t *d, uint64_t pattern, size_t len,
+                         size_t size) {
+    if (len >= VEC_SIZE) {
+        const vec_t v = vec_set1_64(pattern);
+        uint8_t *const last = d + len - VEC_SIZE;
+        // Unaligned head and tail, aligned stores in between
+        vec_storeu(d, v);
+        for (uint8_t *p = (uint8_t *)vec_align_down(d + VEC_SIZE); p < last;
+             p += VEC_SIZE)
+            vec_store(p, v);
+        vec_storeu(last, v);
+        return;
     }
-    // Need to start from the tail due to overlap
-    uint8_t *d = (uint8_t *)dest + len;
-    const uint8_t *s = (const uint8_t *)src + len;
+    if (len >= 8) {
+        uint8_t *const last = d + len - 8;
+        for (; d < last; d += 8) __builtin_memcpy(d, &pattern, 8);
+        __builtin_memcpy(last, &pattern, 8);
+        return;
+    }
+    for (; len; len -= size, d += size) store_elem(d, pattern, size);
+}
+#else
+static void fill_pattern(uint8_t *d, uint64_t pattern, size_t len,
+                         size_t size) {
+    uint8_t *const tail = d + len;
+    const uintptr_t mask = sizeof(uintptr_t) - 1;
+
+    // Word stores need whole elements in a word
+    if (size <= sizeof(uintptr_t)) {
+        // Set 'head' to the first and 'body' to the last word boundary
+        uint8_t *const head = (uint8_t *)(((uintptr_t)d + mask) & ~mask);
+        uintptr_t *const body = (uintptr_t *)((uintptr_t)tail & ~mask);
+        if (head <= (uint8_t *)body) {
+            // Copy head
+            for (; d < head; d += size) store_elem(d, pattern, size);
+            // Copy body
+            uintptr_t *dw = (uintptr_t *)(void *)d;
+            while (dw < body) *(dw++) = (uintptr_t)pattern;
+            d = (uint8_t *)dw;
+        }
+    }
+    // Copy tail
+    for (; d < tail; d += size) store_elem(d, pattern, size);
+}
+#endif
+
+uint16_t *memset16(uint16_t *dest, uint16_t value, size_t count) {
+    fill_pattern((uint8_t *)dest, value * 0x0001000100010001ULL,
+                 count * sizeof(value), sizeof(value));
+    return dest;
+}
+
+uint32_t *memset32(uint32_t *dest, uint32_t value, size_t count) {
+    fill_pattern((uint8_t *)dest, value * 0x0000000100000001ULL,
+                 count * sizeof(value), sizeof(value));
+    return dest;
+}
+
+uint64_t *memset64(uint64_t *dest, uint64_t value, size_t count) {
+    fill_pattern((uint8_t *)dest, value, count * sizeof(value), sizeof(value));
+    return dest;
+}
+
+#if defined(NOC_SIMD)
+
+#ifndef MEMMOVE_STD_MOVSB_THRESHOLD
+// Backward copies of at least this size use `std; rep movsb`. Most cores only
+// have fast strings for forward copies, so it is disabled (0) by default.
+#define MEMMOVE_STD_MOVSB_THRESHOLD 0
+#endif
+
+// Copy from the tail for `dest` > `src` with overlap. The first and the last
+// vectors of the source are loaded upfront and stored at the very end, so the
+// loop can use aligned stores without clobbering source bytes not yet read:
+// each store only hits source bytes above the ones already loaded.
+static void memmove_backward(uint8_t *d, const uint8_t *s, size_t len) {
+    if (len <= 2 * VEC_SIZE) {
+        vec_move_short(d, s, len);
+        return;
+    }
+#if MEMMOVE_STD_MOVSB_THRESHOLD
+    if (len >= MEMMOVE_STD_MOVSB_THRESHOLD) {
+        d += len - 1;
+        s += len - 1;
+        __asm__ volatile("std\n"
+                         "rep movsb\n"
+                         "cld\n"
+                         : "+D"(d), "+S"(s), "+c"(len)
+                         :
+                         : "memory");
+        return;
+    }
+#endif
+    const vec_t head = vec_loadu(s);
+    const vec_t tail = vec_loadu(s + len - VEC_SIZE);
+
+    // Align end of destination down to the vector boundary
+    const size_t skew = (uintptr_t)(d + len) & (VEC_SIZE - 1);
+    uint8_t *dp = d + len - skew;
+    const uint8_t *sp = s + len - skew;
+
+    while (dp - d > 5 * VEC_SIZE) {
+        vec_t v0 = vec_loadu(sp - VEC_SIZE);
+        vec_t v1 = vec_loadu(sp - 2 * VEC_SIZE);
+        vec_t v2 = vec_loadu(sp - 3 * VEC_SIZE);
+        vec_t v3 = vec_loadu(sp - 4 * VEC_SIZE);
+        vec_store(dp - VEC_SIZE, v0);
+        vec_store(dp - 2 * VEC_SIZE, v1);
+        vec_store(dp - 3 * VEC_SIZE, v2);
+        vec_store(dp - 4 * VEC_SIZE, v3);
+        dp -= 4 * VEC_SIZE;
+        sp -= 4 * VEC_SIZE;
+    }
+    // Remaining bytes below first VEC_SIZE are covered by `head`
+    while (dp - d > VEC_SIZE) {
+        dp -= VEC_SIZE;
+        sp -= VEC_SIZE;
+        vec_store(dp, vec_loadu(sp));
+    }
+    vec_storeu(d + len - VEC_SIZE, tail);
+    vec_storeu(d, head);
+}
+
+// Copy from the head for `dest` < `src` with overlap. `rep movsb` loses its
+// fast path when source and destination are closer than a cache line, so use
+// the mirror image of memmove_backward().
+static void memmove_forward(uint8_t *d, const uint8_t *s, size_t len) {
+    if (len <= 2 * VEC_SIZE) {
+        vec_move_short(d, s, len);
+        return;
+    }
+    const vec_t head = vec_loadu(s);
+    const vec_t tail = vec_loadu(s + len - VEC_SIZE);
+    uint8_t *const end = d + len;
+
+    // Align start of destination up to the vector boundary
+    const size_t skew = VEC_SIZE - ((uintptr_t)d & (VEC_SIZE - 1));
+    uint8_t *dp = d + skew;
+    const uint8_t *sp = s + skew;
+
+    while (end - dp > 5 * VEC_SIZE) {
+        vec_t v0 = vec_loadu(sp);
+        vec_t v1 = vec_loadu(sp + VEC_SIZE);
+        vec_t v2 = vec_loadu(sp + 2 * VEC_SIZE);
+        vec_t v3 = vec_loadu(sp + 3 * VEC_SIZE);
+        vec_store(dp, v0);
+        vec_store(dp + VEC_SIZE, v1);
+        vec_store(dp + 2 * VEC_SIZE, v2);
+        vec_store(dp + 3 * VEC_SIZE, v3);
+        dp += 4 * VEC_SIZE;
+        sp += 4 * VEC_SIZE;
+    }
+    // Remaining bytes above last VEC_SIZE are covered by `tail`
+    while (end - dp > VEC_SIZE) {
+        vec_store(dp, vec_loadu(sp));
+        dp += VEC_SIZE;
+        sp += VEC_SIZE;
+    }
+    vec_storeu(d, head);
+    vec_storeu(end - VEC_SIZE, tail);
+}
+#else
+// Generic word-at-a-time copy from the tail for `dest` > `src` with overlap.
+static void memmove_backward(uint8_t *dest, const uint8_t *src, size_t len) {
+    uint8_t *d = dest + len;
+    const uint8_t *s = src + len;
     uintptr_t *dw;
     const uintptr_t *sw;
     const uintptr_t mask = sizeof(*dw) - 1;
-    uint8_t *const tail = (uint8_t *)dest;
+    uint8_t *const tail = dest;
     uint8_t *head = tail;
 
     // Set 'body' to the last word boundary
     uintptr_t *const body = (uintptr_t *)(((uintptr_t)tail + mask) & ~mask);
 
     if (((uintptr_t)d & mask) == ((uintptr_t)s & mask) &&
-        (uintptr_t)tail > ((uintptr_t)d & ~mask))
+        (uintptr_t)tail <= ((uintptr_t)d & ~mask))
         // Set 'head' to the first word boundary
         head = (uint8_t *)((uintptr_t)d & ~mask);
 
@@ -135,6 +382,24 @@ void *memmove(void *dest, const void *src, size_t len) {
     s = (const uint8_t *)sw;
     d = (uint8_t *)dw;
     while (d > tail) *(--d) = *(--s);
+}
+#endif
+
+void *memmove(void *dest, const void *src, size_t len) {
+#if defined(NOC_SIMD)
+    if ((uintptr_t)dest < (uintptr_t)src &&
+        (uintptr_t)dest + len > (uintptr_t)src) {
+        memmove_forward((uint8_t *)dest, (const uint8_t *)src, len);
+        return dest;
+    }
+#endif
+    if ((uintptr_t)dest <= (uintptr_t)src ||
+        (uintptr_t)dest >= (uintptr_t)src + len) {
+        // No overlap, so just use memcpy().
+        return memcpy(dest, src, len);
+    }
+    // Need to start from the tail due to overlap
+    memmove_backward((uint8_t *)dest, (const uint8_t *)src, len);
     return dest;
 }
 
@@ -0,0 +1,133 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <memcpy_async.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "noc_internal/common.h"
+
+#ifndef MEMCPY_ASYNC_CHUNK
+// Bytes copied by software engine per step
+#define MEMCPY_ASYNC_CHUNK 4096
+#endif
+
+STATIC_ASSERT((MEMCPY_ASYNC_QUEUE & (MEMCPY_ASYNC_QUEUE - 1)) == 0);
+
+struct copy_req {
+    void *dest;
+    const void *src;
+    size_t len;
+    memcpy_async_cb_t cb;
+};
+
+// Queue of copies: `head` is advanced by the submitter, `tail` by the
+// completion context. Both are free running counters and serve as tickets.
+// `busy` is owned by whoever starts the next copy, and stays set while the
+// copy is in flight.
+static struct {
+    const struct memcpy_async_ops *ops;
+    struct copy_req req[MEMCPY_ASYNC_QUEUE];
+    uint32_t head;
+    uint32_t tail;
+} queue;
+
+static bool busy;
+
+static inline uint32_t load(const uint32_t *p) {
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+// Start the oldest queued copy unless one is in flight. Called both after
+// submission and after completion, the loop covers the race when a copy is
+// queued while `busy` is being released.
+static void kick(void) {
+    while (load(&queue.tail) != load(&queue.head)) {
+        if (__atomic_exchange_n(&busy, true, __ATOMIC_SEQ_CST)) return;
+        const uint32_t t = load(&queue.tail);
+        if (t != load(&queue.head)) {
+            const struct copy_req *r = &queue.req[t % MEMCPY_ASYNC_QUEUE];
+            queue.ops->start(r->dest, r->src, r->len);
+            return;
+        }
+        __atomic_store_n(&busy, false, __ATOMIC_SEQ_CST);
+    }
+}
+
+void memcpy_async_register(const struct memcpy_async_ops *ops) {
+    queue.ops = ops;
+}
+
+void memcpy_async_complete(void) {
+    const uint32_t t = load(&queue.tail);
+    const struct copy_req *r = &queue.req[t % MEMCPY_ASYNC_QUEUE];
+    if (r->cb) r->cb(r->dest, r->len);
+    __atomic_store_n(&queue.tail, t + 1, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&busy, false, __ATOMIC_SEQ_CST);
+    kick();
+}
+
+void memcpy_async_poll(void) {
+    if (queue.ops && queue.ops->poll) queue.ops->poll();
+}
+
+bool memcpy_done(memcpy_ticket_t ticket) {
+    return (int32_t)(load(&queue.tail) - ticket) >= 0;
+}
+
+void memcpy_wait(memcpy_ticket_t ticket) {
+    while (!memcpy_done(ticket)) memcpy_async_poll();
+}
+
+memcpy_ticket_t memcpy_async(void *restrict dest, const void *restrict src,
+                             size_t len, memcpy_async_cb_t cb) {
+    const uint32_t h = queue.head;
+
+    // Synchronous copy can't overtake queued ones
+    if (!queue.ops || (len < queue.ops->min_len && load(&queue.tail) == h)) {
+        memcpy(dest, src, len);
+        if (cb) cb(dest, len);
+        return h;
+    }
+    while (h - load(&queue.tail) >= MEMCPY_ASYNC_QUEUE) memcpy_async_poll();
+
+    queue.req[h % MEMCPY_ASYNC_QUEUE] =
+        (struct copy_req){.dest = dest, .src = src, .len = len, .cb = cb};
+    __atomic_store_n(&queue.head, h + 1, __ATOMIC_SEQ_CST);
+    kick();
+    return h + 1;
+}
+
+// Software engine: copy in flight, advanced by poll()
+static struct {
+    uint8_t *dest;
+    const uint8_t *src;
+    size_t len;
+} soft;
+
+static void soft_start(void *dest, const void *src, size_t len) {
+    soft.dest = dest;
+    soft.src = src;
+    soft.len = len;
+}
+
+static void soft_poll(void) {
+    if (!soft.dest) return;
+    const size_t n = MIN(soft.len, (size_t)MEMCPY_ASYNC_CHUNK);
+    memcpy(soft.dest, soft.src, n);
+    soft.dest += n;
+    soft.src += n;
+    soft.len -= n;
+    if (!soft.len) {
+        soft.dest = NULL;
+        memcpy_async_complete();
+    }
+}
+
+const struct memcpy_async_ops memcpy_async_soft = {
+    .start = soft_start, .poll = soft_poll, .min_len = 256};
@@ -0,0 +1,262 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <checksum.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "noc_internal/common.h"
+#include "noc_internal/simd.h"
+
+#if defined(ARCH_X86_64) && defined(__SSE4_2__)
+#include <immintrin.h>
+#define CRC32C_HW 1
+#endif
+
+// Kernels below copy when `d` is not NULL. They are always inlined, so the
+// checks are resolved at compile time for both variants.
+#define CSUM_INLINE static inline __attribute__((always_inline))
+
+// Internet checksum: 32-bit halves of 64-bit words are added into 64-bit
+// accumulators, which can't overflow for any practical length. Since 2^32 and
+// 2^16 are both 1 modulo 0xffff, the result folds into the same 16-bit ones'
+// complement sum.
+CSUM_INLINE uint32_t csum_copy(uint8_t *d, const uint8_t *s, size_t len,
+                               uint32_t sum) {
+    uint64_t a0 = sum, a1 = 0;
+
+#if defined(NOC_SIMD)
+    if (len >= 2 * VEC_SIZE) {
+        const vec_t lo32 = vec_set1_64(0xffffffff);
+        vec_t acc0 = vec_zero(), acc1 = vec_zero();
+        for (; len >= 2 * VEC_SIZE; len -= 2 * VEC_SIZE, s += 2 * VEC_SIZE) {
+            const vec_t v0 = vec_loadu(s);
+            const vec_t v1 = vec_loadu(s + VEC_SIZE);
+            if (d) {
+                vec_storeu(d, v0);
+                vec_storeu(d + VEC_SIZE, v1);
+                d += 2 * VEC_SIZE;
+            }
+            acc0 = vec_add64(acc0, vec_add64(vec_and(v0, lo32),
+                                             vec_srli64(v0, 32)));
+            acc1 = vec_add64(acc1, vec_add64(vec_and(v1, lo32),
+                                             vec_srli64(v1, 32)));
+        }
+        uint64_t lanes[VEC_SIZE / 8];
+        vec_storeu(lanes, vec_add64(acc0, acc1));
+        for (size_t i = 0; i < VEC_SIZE / 8; i++) a1 += lanes[i];
+    }
+#endif
+    for (; len >= 16; len -= 16, s += 16) {
+        uint64_t w0, w1;
+        __builtin_memcpy(&w0, s, 8);
+        __builtin_memcpy(&w1, s + 8, 8);
+        if (d) {
+            __builtin_memcpy(d, &w0, 8);
+            __builtin_memcpy(d + 8, &w1, 8);
+            d += 16;
+        }
+        a0 += (uint32_t)w0 + (w0 >> 32);
+        a1 += (uint32_t)w1 + (w1 >> 32);
+    }
+    if (len) {
+        // Pad the tail with zeroes
+        uint8_t t[16] = {0};
+        for (size_t i = 0; i < len; i++) t[i] = s[i];
+        if (d)
+            for (size_t i = 0; i < len; i++) d[i] = t[i];
+        uint64_t w0, w1;
+        __builtin_memcpy(&w0, t, 8);
+        __builtin_memcpy(&w1, t + 8, 8);
+        a0 += (uint32_t)w0 + (w0 >> 32);
+        a1 += (uint32_t)w1 + (w1 >> 32);
+    }
+    a0 += a1;
+    if (a0 < a1) a0++;
+    a0 = (a0 & 0xffffffff) + (a0 >> 32);
+    a0 = (a0 & 0xffffffff) + (a0 >> 32);
+    return (uint32_t)a0;
+}
+
+uint32_t csum_partial(const void *buf, size_t len, uint32_t sum) {
+    return csum_copy(NULL, (const uint8_t *)buf, len, sum);
+}
+
+uint32_t memcpy_csum(void *restrict dest, const void *restrict src, size_t len,
+                     uint32_t sum) {
+    return csum_copy((uint8_t *)dest, (const uint8_t *)src, len, sum);
+}
+
+// Slicing-by-8 tables: t[0] is the classic byte-at-a-time table, t[k] gives
+// the CRC of a byte followed by k zero bytes. Built on first use to keep them
+// out of the image when unused.
+struct crc_table {
+    uint32_t t[8][256];
+    uint32_t ready;
+};
+
+static const struct crc_table *crc_table(struct crc_table *tab,
+                                         uint32_t poly) {
+    if (__atomic_load_n(&tab->ready, __ATOMIC_ACQUIRE)) return tab;
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (size_t k = 0; k < 8; k++) c = (c >> 1) ^ (poly & -(c & 1));
+        tab->t[0][i] = c;
+    }
+    for (size_t i = 0; i < 256; i++)
+        for (size_t k = 1; k < 8; k++)
+            tab->t[k][i] = (tab->t[k - 1][i] >> 8) ^
+                           tab->t[0][tab->t[k - 1][i] & 0xff];
+    __atomic_store_n(&tab->ready, 1, __ATOMIC_RELEASE);
+    return tab;
+}
+
+CSUM_INLINE uint32_t crc_copy(const struct crc_table *tab, uint8_t *d,
+                              const uint8_t *s, size_t len, uint32_t crc) {
+    crc = ~crc;
+    for (; len >= 8; len -= 8, s += 8) {
+        uint64_t w;
+        __builtin_memcpy(&w, s, 8);
+        if (d) {
+            __builtin_memcpy(d, &w, 8);
+            d += 8;
+        }
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        w = __builtin_bswap64(w);
+#endif
+        w ^= crc;
+        crc = tab->t[7][w & 0xff] ^ tab->t[6][(w >> 8) & 0xff] ^
+              tab->t[5][(w >> 16) & 0xff] ^ tab->t[4][(w >> 24) & 0xff] ^
+              tab->t[3][(w >> 32) & 0xff] ^ tab->t[2][(w >> 40) & 0xff] ^
+              tab->t[1][(w >> 48) & 0xff] ^ tab->t[0][w >> 56];
+    }
+    for (; len; len--, s++) {
+        if (d) *(d++) = *s;
+        crc = (crc >> 8) ^ tab->t[0][(crc ^ *s) & 0xff];
+    }
+    return ~crc;
+}
+
+static struct crc_table crc32_tab;
+
+uint32_t crc32(uint32_t crc, const void *buf, size_t len) {
+    return crc_copy(crc_table(&crc32_tab, 0xedb88320), NULL,
+                    (const uint8_t *)buf, len, crc);
+}
+
+uint32_t memcpy_crc32(void *restrict dest, const void *restrict src,
+                      size_t len, uint32_t crc) {
+    return crc_copy(crc_table(&crc32_tab, 0xedb88320), (uint8_t *)dest,
+                    (const uint8_t *)src, len, crc);
+}
+
+#if defined(CRC32C_HW)
+#ifndef CRC32C_BLOCK
+// Length of each of 3 interleaved streams
+#define CRC32C_BLOCK 128
+#endif
+
+// Multiply `a` and `b` modulo polynomial, bit 31 is x^0 in reflected order
+static uint32_t multmodp(uint32_t a, uint32_t b, uint32_t poly) {
+    uint32_t p = 0;
+    for (uint32_t m = 1U << 31; m; m >>= 1) {
+        if (a & m) p ^= b;
+        b = (b >> 1) ^ (poly & -(b & 1));
+    }
+    return p;
+}
+
+// Table to advance CRC register over CRC32C_BLOCK zero bytes, byte by byte
+// of the register, as the operation is linear.
+struct crc_shift {
+    uint32_t t[4][256];
+    uint32_t ready;
+};
+
+static const struct crc_shift *crc32c_shift_table(void) {
+    static struct crc_shift tab;
+    if (__atomic_load_n(&tab.ready, __ATOMIC_ACQUIRE)) return &tab;
+    // x^(8 * CRC32C_BLOCK) by squaring x^8
+    uint32_t xn = 1U << 31, x8 = 1U << 23;
+    for (size_t n = CRC32C_BLOCK; n; n >>= 1) {
+        if (n & 1) xn = multmodp(x8, xn, 0x82f63b78);
+        x8 = multmodp(x8, x8, 0x82f63b78);
+    }
+    for (uint32_t i = 0; i < 256; i++)
+        for (size_t k = 0; k < 4; k++)
+            tab.t[k][i] = multmodp(xn, i << (8 * k), 0x82f63b78);
+    __atomic_store_n(&tab.ready, 1, __ATOMIC_RELEASE);
+    return &tab;
+}
+
+static inline uint32_t crc_shift(const struct crc_shift *tab, uint32_t c) {
+    return tab->t[0][c & 0xff] ^ tab->t[1][(c >> 8) & 0xff] ^
+           tab->t[2][(c >> 16) & 0xff] ^ tab->t[3][c >> 24];
+}
+
+// The crc32 instruction has 3 cycles latency and 1 cycle throughput, so
+// process 3 independent streams and join them: CRC of A|B is CRC of A
+// advanced over |B| zero bytes, xor CRC of B computed from zero.
+CSUM_INLINE uint32_t crc32c_copy(uint8_t *d, const uint8_t *s, size_t len,
+                                 uint32_t crc) {
+    uint64_t c = (uint32_t)~crc;
+    if (len >= 3 * CRC32C_BLOCK) {
+        const struct crc_shift *tab = crc32c_shift_table();
+        for (; len >= 3 * CRC32C_BLOCK; len -= 3 * CRC32C_BLOCK) {
+            uint64_t c1 = 0, c2 = 0;
+            for (size_t i = 0; i < CRC32C_BLOCK; i += 8, s += 8) {
+                uint64_t w0, w1, w2;
+                __builtin_memcpy(&w0, s, 8);
+                __builtin_memcpy(&w1, s + CRC32C_BLOCK, 8);
+                __builtin_memcpy(&w2, s + 2 * CRC32C_BLOCK, 8);
+                if (d) {
+                    __builtin_memcpy(d + i, &w0, 8);
+                    __builtin_memcpy(d + i + CRC32C_BLOCK, &w1, 8);
+                    __builtin_memcpy(d + i + 2 * CRC32C_BLOCK, &w2, 8);
+                }
+                c = _mm_crc32_u64(c, w0);
+                c1 = _mm_crc32_u64(c1, w1);
+                c2 = _mm_crc32_u64(c2, w2);
+            }
+            c = crc_shift(tab, (uint32_t)c) ^ (uint32_t)c1;
+            c = crc_shift(tab, (uint32_t)c) ^ (uint32_t)c2;
+            s += 2 * CRC32C_BLOCK;
+            if (d) d += 3 * CRC32C_BLOCK;
+        }
+    }
+    for (; len >= 8; len -= 8, s += 8) {
+        uint64_t w;
+        __builtin_memcpy(&w, s, 8);
+        if (d) {
+            __builtin_memcpy(d, &w, 8);
+            d += 8;
+        }
+        c = _mm_crc32_u64(c, w);
+    }
+    crc = (uint32_t)c;
+    for (; len; len--, s++) {
+        if (d) *(d++) = *s;
+        crc = _mm_crc32_u8(crc, *s);
+    }
+    return ~crc;
+}
+#else
+static struct crc_table crc32c_tab;
+
+CSUM_INLINE uint32_t crc32c_copy(uint8_t *d, const uint8_t *s, size_t len,
+                                 uint32_t crc) {
+    return crc_copy(crc_table(&crc32c_tab, 0x82f63b78), d, s, len, crc);
+}
+#endif
+
+uint32_t crc32c(uint32_t crc, const void *buf, size_t len) {
+    return crc32c_copy(NULL, (const uint8_t *)buf, len, crc);
+}
+
+uint32_t memcpy_crc32c(void *restrict dest, const void *restrict src,
+                       size_t len, uint32_t crc) {
+    return crc32c_copy((uint8_t *)dest, (const uint8_t *)src, len, crc);
+}
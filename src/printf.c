@@ -4,12 +4,19 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT.
 
+#include <dlog.h>
+#include <encoding.h>
 #include <noc_internal/common.h>
+#include <noc_internal/dtoa.h>
+#include <noc_internal/stdio.h>
+#include <print.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <strbuf.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -20,10 +27,6 @@ static const char ERROR_STR[] = "<ERROR>\n";
 #define MAX_FORMAT 128
 #endif
 
-#ifndef PRINTF_BUFFER_SIZE
-#define PRINTF_BUFFER_SIZE 256
-#endif
-
 // Get digit in base `d`, update n to n/d
 static uint32_t get_digit(uint64_t *n, uint32_t d) {
     uint32_t r = 0;
@@ -54,352 +57,724 @@ static inline char char_digit(unsigned char c, char a) {
     return (char)(c > 9 ? (c + a - 10) : (c + '0'));
 }
 
-typedef bool (*write_char)(void *state, int c);
+// Output sink. Text is passed as spans, padding as a repeated character.
+struct sink {
+    bool (*write)(void *state, const char *str, size_t len);
+    bool (*fill)(void *state, char c, size_t len);
+};
 
-static int formatter(write_char write, void *state, const char *format,
-                     va_list args) {
-    char digits[68];  // Buffer for text representation.
+// Output text parts of a formatted double, with runs of zeroes between them
+static bool write_dtoa(const struct sink *out, void *state,
+                       const struct dtoa_text *t) {
+    const char *p = t->buf;
+    for (size_t i = 0; i < 3; i++) {
+        if (t->len[i] && !out->write(state, p, t->len[i])) return false;
+        p += t->len[i];
+        if (i < 2 && t->zeros[i] && !out->fill(state, '0', t->zeros[i]))
+            return false;
+    }
+    return true;
+}
 
-    // Flags for format specifier
-    struct fmt {
-        unsigned int left : 1;      // Left-justify
-        unsigned int pad_zero : 1;  // Pad with 0's not spaces
-        unsigned int add_sign : 1;  // Add sign (+) for a positive number
-        unsigned int bit64 : 1;     // Number is 64-bit
-        unsigned int bit16 : 1;     // Number is 16-bit
-        unsigned int bit8 : 1;      // Number is 8-bit
-        unsigned int alt : 1;       // Alternative representation
-        unsigned int space : 1;     // Prepend space
-        unsigned int _pad : 24;     // to avoid warnings on padding
-    } flags;
-
-    uint32_t precision, pad_width = 0;
-    int count = 0;  // Counter for output characters
-    char c;
+// Flags of conversion specification, with the conversion character
+struct fmt {
+    unsigned int left : 1;       // Left-justify
+    unsigned int pad_zero : 1;   // Pad with 0's not spaces
+    unsigned int add_sign : 1;   // Add sign (+) for a positive number
+    unsigned int bit64 : 1;      // Number is 64-bit
+    unsigned int bit16 : 1;      // Number is 16-bit
+    unsigned int bit8 : 1;       // Number is 8-bit
+    unsigned int alt : 1;        // Alternative representation
+    unsigned int space : 1;      // Prepend space
+    unsigned int prec : 1;       // Precision specified
+    unsigned int width_arg : 1;  // Width is passed as argument ('*')
+    unsigned int prec_arg : 1;   // Precision is passed as argument ('*')
+    unsigned int conv : 8;       // Conversion character, 0 if incomplete
+    unsigned int _pad : 13;      // to avoid warnings on padding
+};
 
-    if (!format) return EOF;
+STATIC_ASSERT(sizeof(struct fmt) == sizeof(uint32_t));
 
-    while ((c = *format++)) {
-        if (c != '%') {
-            if (!write(state, c)) return EOF;
-            count++;
-            continue;
-        }
+// Parsed conversion specification
+struct spec {
+    struct fmt flags;
+    uint32_t width;
+    uint32_t precision;
+};
 
-        c = *format++;  // Read format specifier
-        if (c == '%') {
-            if (!write(state, c)) return EOF;
-            count++;
-            continue;
-        } else if (c == 0) {  // Incomplete format flag
-            format = ERROR_STR;
-            continue;
-        }
+// Arguments of conversions, taken from `ap`, or from encoded deferred log
+// record if `ap` is NULL
+struct args {
+    va_list *ap;
+    const uint8_t *rec;
+    const uint8_t *end;
+};
+
+// Take `len` bytes of record, padded to 4 bytes. NULL if record is too short.
+static const uint8_t *rec_take(struct args *a, size_t len) {
+    const size_t slot = (len + 3) & ~(size_t)3;
+    if ((size_t)(a->end - a->rec) < slot) {
+        a->rec = a->end;
+        return NULL;
+    }
+    const uint8_t *p = a->rec;
+    a->rec += slot;
+    return p;
+}
+
+static uint32_t arg_u32(struct args *a) {
+    uint32_t v = 0;
+    if (a->ap) return va_arg(*a->ap, uint32_t);
+    const uint8_t *p = rec_take(a, sizeof(v));
+    if (p) memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t arg_u64(struct args *a) {
+    uint64_t v = 0;
+    if (a->ap) return va_arg(*a->ap, uint64_t);
+    const uint8_t *p = rec_take(a, sizeof(v));
+    if (p) memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static double arg_double(struct args *a) {
+    double v = 0;
+    if (a->ap) return va_arg(*a->ap, double);
+    const uint8_t *p = rec_take(a, sizeof(v));
+    if (p) memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// String argument, or `len` bytes for %H. Records hold the data itself, with
+// strings null-terminated.
+static char *arg_str(struct args *a, size_t len) {
+    if (a->ap) return va_arg(*a->ap, char *);
+    if (!len)
+        len = strnlen((const char *)a->rec, (size_t)(a->end - a->rec)) + 1;
+    return (char *)rec_take(a, len);
+}
+
+// Returned by convert() for invalid specification or argument
+#define FORMAT_ERROR (-2)
 
-        // Zero flags, now that we're in a format
-        flags = (struct fmt){};
-        char sign = 0;
-
-        // Format modifiers can come in any order
-        do {
-            if (c == '-') {
-                // Left-justified ("%-5s")
-                flags.left = 1;
-            } else if (c == '+') {
-                // Handle positive sign (%+d)
-                flags.add_sign = 1;
-            } else if (c == '0') {
-                // Handle padding with 0's
-                flags.pad_zero = 1;
-            } else if (c == '#') {
-                // Alternate format (TBD)
-                flags.alt = 1;
-            } else if (c == ' ') {
-                // Put ' ' instead of '+'
-                flags.space = 1;
-            } else
-                break;
+// Parse conversion specification following '%'. Length modifiers are folded
+// into flags. Returns pointer past the specification.
+static const char *parse_spec(const char *format, struct spec *sp) {
+    char c = *format++;
+
+    *sp = (struct spec){};
+
+    // Format modifiers can come in any order
+    do {
+        if (c == '-') {
+            // Left-justified ("%-5s")
+            sp->flags.left = 1;
+        } else if (c == '+') {
+            // Handle positive sign (%+d)
+            sp->flags.add_sign = 1;
+        } else if (c == '0') {
+            // Handle padding with 0's
+            sp->flags.pad_zero = 1;
+        } else if (c == '#') {
+            // Alternate format (TBD)
+            sp->flags.alt = 1;
+        } else if (c == ' ') {
+            // Put ' ' instead of '+'
+            sp->flags.space = 1;
+        } else
+            break;
+        c = *format++;
+    } while (true);
+
+    // Process padding width
+    if (c == '*') {
+        sp->flags.width_arg = 1;
+        c = *format++;
+    } else {
+        while (isdigit(c)) {
+            sp->width = (10 * sp->width) + c - '0';
             c = *format++;
-        } while (true);
+        }
+    }
 
-        // Process padding width
-        pad_width = 0;
+    // Extract precision
+    if (c == '.') {
+        sp->flags.prec = 1;
+        c = *format++;
         if (c == '*') {
-            int p = va_arg(args, int);
-            pad_width = (p < 0) ? 0 : (uint32_t)p;
+            sp->flags.prec_arg = 1;
             c = *format++;
         } else {
             while (isdigit(c)) {
-                pad_width = (10 * pad_width) + c - '0';
+                sp->precision = (10 * sp->precision) + c - '0';
                 c = *format++;
             }
         }
+    }
 
-        // Extract precision
-        precision = 0;
-        if (c == '.') {
+    // Handle length & type
+    if (c == 'h') {
+        c = *format++;
+        if (c == 'h') {
+            sp->flags.bit8 = 1;  // %hh specifier
+            c = *format++;
+        } else
+            sp->flags.bit16 = 1;  // %h specifier
+    } else if (c == 'l') {
+        sp->flags.bit64 = 1;
+        c = *format++;
+        if (c == 'l') {
+            // TODO: add support for long long?
             c = *format++;
-            if (c == '*') {
-                int p = va_arg(args, int);
-                precision = (p < 0) ? 0 : (uint32_t)p;
-                c = *format++;
-            } else {
-                while (isdigit(c)) {
-                    precision = (10 * precision) + c - '0';
-                    c = *format++;
-                }
-            }
         }
+    } else if (c == 'z') {
+        if (sizeof(size_t) == sizeof(uint64_t)) sp->flags.bit64 = 1;
+        c = *format++;
+    } else if (c == 'p') {
+        if (sizeof(void *) == sizeof(uint64_t)) sp->flags.bit64 = 1;
+        sp->flags.pad_zero = 1;
+    } else if (c == 'j') {
+        if (sizeof(intmax_t) == sizeof(uint64_t)) sp->flags.bit64 = 1;
+        c = *format++;
+    } else if (c == 't') {
+        if (sizeof(ptrdiff_t) == sizeof(uint64_t)) sp->flags.bit64 = 1;
+        c = *format++;
+    }
 
-        if (pad_width > MAX_FORMAT || precision > MAX_FORMAT) {
-            format = ERROR_STR;
-            continue;
-        }
+    sp->flags.conv = (unsigned char)c;
+    // Stay at the terminating null of incomplete specification
+    return c ? format : format - 1;
+}
 
-        char *value_str = NULL;  // text representation of argument
+static inline bool is_float_conv(char c) {
+    const char conv = (char)(c | 0x20);
+    return conv == 'f' || conv == 'e' || conv == 'g' || conv == 'a';
+}
 
-        if (c == 's') {
-            value_str = va_arg(args, char *);
-            if (value_str == NULL) value_str = (char *)"[null]";
-        } else if (c == 'H') {
-            // Extension: hex dump output (e.g. %32H will print 32 bytes)
-            value_str = va_arg(args, char *);
+// Output text padded to `width`
+static int emit_padded(const struct sink *out, void *state, struct fmt flags,
+                       uint32_t width, const char *str, size_t len) {
+    const size_t pad_len = (len < width) ? width - len : 0;
 
-            if (!value_str || !precision) {
-                // Hex dump requires precision
-                format = ERROR_STR;
-                continue;
-            }
+    // Padding right if requested
+    if (pad_len && !flags.left &&
+        !out->fill(state, flags.pad_zero ? '0' : ' ', pad_len))
+        return EOF;
+    if (!out->write(state, str, len)) return EOF;
+    // Padding left if requested
+    if (pad_len && flags.left && !out->fill(state, ' ', pad_len)) return EOF;
+    return (int)(len + pad_len);
+}
 
-            while (precision) {
-                if (!write(state, char_digit(*value_str >> 4, 'a'))) return EOF;
-                count++;
-                if (!write(state, char_digit(*value_str & 0xf, 'a')))
-                    return EOF;
-                count++;
-                precision--;
-                value_str++;
-            }
-            continue;
-        } else {
-            uint32_t base = 10;
-            uint64_t v;
+// Output string limited to `precision` characters if it is not zero
+static int emit_str(const struct sink *out, void *state, struct fmt flags,
+                    uint32_t width, uint32_t precision, const char *str) {
+    if (str == NULL) str = "[null]";
+    const size_t len = precision ? strnlen(str, precision) : strlen(str);
+    return emit_padded(out, state, flags, width, str, len);
+}
 
-            // Handle length & type
-            if (c == 'h') {
-                c = *format++;
-                if (c == 'h') {
-                    flags.bit8 = 1;  // %hh specifier
-                    c = *format++;
+static int emit_float(const struct sink *out, void *state, struct fmt flags,
+                      uint32_t width, int32_t prec, double value) {
+    struct dtoa_text t;
+    char sign = 0;
+
+    if (prec > DTOA_MAX_PRECISION) return FORMAT_ERROR;
+    dtoa_format(&t, value, (char)flags.conv, prec, flags.alt);
+    if (t.negative)
+        sign = '-';
+    else if (flags.add_sign)
+        sign = '+';
+    else if (flags.space)
+        sign = ' ';
+
+    const size_t len = (sign != 0) + t.len[0] + t.len[1] + t.len[2] +
+                       t.zeros[0] + t.zeros[1];
+    const size_t pad_len = (len < width) ? width - len : 0;
+    // Zeroes go after the sign, inf and nan are padded with spaces
+    const bool pad_zero = flags.pad_zero && t.finite;
+
+    if (pad_len && !flags.left && !pad_zero && !out->fill(state, ' ', pad_len))
+        return EOF;
+    if (sign && !out->write(state, &sign, 1)) return EOF;
+    if (pad_len && !flags.left && pad_zero && !out->fill(state, '0', pad_len))
+        return EOF;
+    if (!write_dtoa(out, state, &t)) return EOF;
+    if (pad_len && flags.left && !out->fill(state, ' ', pad_len)) return EOF;
+    return (int)(len + pad_len);
+}
+
+// Output integer `v`, already truncated to its length modifier
+static int emit_int(const struct sink *out, void *state, struct fmt flags,
+                    uint32_t width, uint32_t precision, uint64_t v) {
+    char digits[68];  // Buffer for text representation.
+    const char c = (char)flags.conv;
+    uint32_t base = 10;
+    char sign = 0;
+    int count = 0;
+
+    switch (c) {
+        case 'd':
+            // sign extension for smaller types
+            if (flags.bit16) {
+                int16_t vv = (int16_t)v;
+                if (vv < 0) {
+                    sign = '-';
+                    v = -vv;
                 } else
-                    flags.bit16 = 1;  // %h specifier
-            } else if (c == 'l') {
-                flags.bit64 = 1;
-                c = *format++;
-                if (c == 'l') {
-                    // TODO: add support for long long?
-                    c = *format++;
+                    v = (uint16_t)vv;
+            } else if (flags.bit8) {
+                int8_t vv = (int8_t)v;
+                if (vv < 0) {
+                    sign = '-';
+                    v = -vv;
+                } else
+                    v = (uint8_t)vv;
+            } else if (flags.bit64) {
+                if ((int64_t)v < 0) {
+                    sign = '-';
+                    if (v != (1ULL << 63)) v = -v;
+                } else if (flags.add_sign) {
+                    sign = '+';
+                }
+            } else {
+                if ((int)v < 0) {
+                    sign = '-';
+                    if (v != (1ULL << 31)) v = -(int)v;
+                } else if (flags.add_sign) {
+                    sign = '+';
                 }
-            } else if (c == 'z') {
-                if (sizeof(size_t) == sizeof(uint64_t)) flags.bit64 = 1;
-                c = *format++;
-            } else if (c == 'p') {
-                if (sizeof(void *) == sizeof(uint64_t)) flags.bit64 = 1;
-                flags.pad_zero = 1;
-            } else if (c == 'j') {
-                if (sizeof(intmax_t) == sizeof(uint64_t)) flags.bit64 = 1;
-                c = *format++;
-            } else if (c == 't') {
-                if (sizeof(ptrdiff_t) == sizeof(uint64_t)) flags.bit64 = 1;
-                c = *format++;
             }
+            if (!sign && flags.space) sign = ' ';
+            break;
+        case 'u':
+            break;
+        case 'p':
+            // Pointers printed with 0x prefix
+            base = 16;
+            if (!out->write(state, "0x", 2)) return EOF;
+            count += 2;
+            break;
+        case 'X':
+        case 'x':
+            base = 16;
+            break;
+        case 'o':  // Octal numbers starts with 0
+            base = 8;
+            if (!out->write(state, "0", 1)) return EOF;
+            count++;
+            break;
+        case 'b':
+            base = 2;
+            break;
+        default:
+            // Unsupported format specifier
+            return EOF;
+    }
 
-            if (c == 'c') {  // '%c', read char
-                c = va_arg(args, int);
-                if (!write(state, c)) return EOF;
-                count++;
-                continue;
-            }
+    // Leave space for the terminating null.
+    if (precision > sizeof(digits) - 1) return FORMAT_ERROR;
+    // Precision sets the number of digits, the 0 flag is ignored
+    if (flags.prec) flags.pad_zero = 0;
 
-            if (flags.bit64) {
-                v = va_arg(args, uint64_t);
-            } else {
-                v = va_arg(args, uint32_t);
-                if (flags.bit16) v = v & 0xffff;
-                if (flags.bit8) v = v & 0xff;
-            }
+    // Convert integer to string starting backwards
+    char *value_str = digits + sizeof(digits);
 
-            switch (c) {
-                case 'd':
-                    // sign extension for smaller types
-                    if (flags.bit16) {
-                        int16_t vv = (int16_t)v;
-                        if (vv < 0) {
-                            sign = '-';
-                            v = -vv;
-                        } else
-                            v = (uint16_t)vv;
-                    } else if (flags.bit8) {
-                        int8_t vv = (int8_t)v;
-                        if (vv < 0) {
-                            sign = '-';
-                            v = -vv;
-                        } else
-                            v = (uint8_t)vv;
-                    } else if (flags.bit64) {
-                        if ((int64_t)v < 0) {
-                            sign = '-';
-                            if (v != (1ULL << 63)) v = -v;
-                        } else if (flags.add_sign) {
-                            sign = '+';
-                        }
-                    } else {
-                        if ((int)v < 0) {
-                            sign = '-';
-                            if (v != (1ULL << 31)) v = -(int)v;
-                        } else if (flags.add_sign) {
-                            sign = '+';
-                        }
-                    }
-                    if (!sign && flags.space) sign = ' ';
-                    break;
-                case 'u':
-                    break;
-                case 'p':
-                    // Pointers printed with 0x prefix
-                    base = 16;
-                    if (!write(state, '0')) return EOF;
-                    count++;
-                    if (!write(state, 'x')) return EOF;
-                    count++;
-                    break;
-                case 'X':
-                case 'x':
-                    base = 16;
-                    break;
-                case 'o':  // Octal numbers starts with 0
-                    base = 8;
-                    if (!write(state, '0')) return EOF;
-                    count++;
-                    break;
-                case 'b':
-                    base = 2;
-                    break;
-                default:
-                    // Unsupported format specifier
-                    format = ERROR_STR;
-                    return EOF;
-            }
+    if (base == 10) {
+        // Converted forward at the start of digits[], then moved to the
+        // end, which is past the longest decimal number
+        const size_t len = (size_t)(u64toa(v, digits) - digits);
+        value_str -= len;
+        memcpy(value_str, digits, len);
+        for (size_t i = len; i < precision; i++) *(--value_str) = '0';
+    } else {
+        char hex = (c == 'X' || c == 'p' || flags.alt) ? 'A' : 'a';
 
-            // Leave space for the terminating null.
-            if (precision > sizeof(digits) - 1) format = ERROR_STR;
+        // Print requested number of digits independent of value
+        for (size_t i = 0; i < precision; i++)
+            *(--value_str) = char_digit(get_digit(&v, base), hex);
 
-            // Unrecognized / unsupported format
-            if (format == ERROR_STR) continue;
+        if (!precision && !v) *(--value_str) = '0';
 
-            // Convert integer to string starting backwards
-            value_str = digits + sizeof(digits) - 1;
-            *value_str = 0;
+        while (v) *(--value_str) = char_digit(get_digit(&v, base), hex);
+    }
 
-            char hex = (c == 'X' || c == 'p' || flags.alt) ? 'A' : 'a';
+    if (sign) {
+        if (flags.pad_zero && !flags.left && width > 1) {
+            // Zeroes go after the sign
+            if (!out->write(state, &sign, 1)) return EOF;
+            count++;
+            width--;
+        } else {
+            *(--value_str) = sign;
+        }
+    }
+
+    const int n =
+        emit_padded(out, state, flags, width, value_str,
+                    (size_t)(digits + sizeof(digits) - value_str));
+    return (n == EOF) ? EOF : count + n;
+}
 
-            // Print requested number of digits independent of value
-            for (size_t i = 0; i < precision; i++)
-                *(--value_str) = char_digit(get_digit(&v, base), hex);
+// Output one conversion, reading its arguments. Returns number of characters
+// written, EOF on output error or unsupported conversion, or FORMAT_ERROR.
+static int convert(const struct sink *out, void *state, const struct spec *sp,
+                   struct args *args) {
+    struct fmt flags = sp->flags;
+    uint32_t precision = sp->precision, pad_width = sp->width;
+    const char c = (char)flags.conv;
 
-            if (!precision && !v) *(--value_str) = '0';
+    if (flags.width_arg) {
+        int p = (int)arg_u32(args);
+        pad_width = (p < 0) ? 0 : (uint32_t)p;
+    }
+    if (flags.prec_arg) {
+        int p = (int)arg_u32(args);
+        precision = (p < 0) ? 0 : (uint32_t)p;
+    }
 
-            while (v) *(--value_str) = char_digit(get_digit(&v, base), hex);
+    if (pad_width > MAX_FORMAT || precision > MAX_FORMAT) return FORMAT_ERROR;
 
-            if (sign) *(--value_str) = sign;
+    if (c == '%') {
+        return out->write(state, "%", 1) ? 1 : EOF;
+    } else if (c == 's') {
+        return emit_str(out, state, flags, pad_width, precision,
+                        arg_str(args, 0));
+    } else if (c == 'H') {
+        // Extension: hex dump output (e.g. %32H will print 32 bytes)
+        const char *data = arg_str(args, precision);
+        char digits[64];
+        int count = 0;
 
-            precision = 0;  // consumed for number outputs
+        // Hex dump requires precision
+        if (!data || !precision) return FORMAT_ERROR;
+
+        // Encode in chunks which fit into digits[]
+        while (precision) {
+            const uint32_t n = MIN(precision, sizeof(digits) / 2);
+            const size_t len = hex_encode(digits, data, n);
+            if (!out->write(state, digits, len)) return EOF;
+            count += (int)len;
+            precision -= n;
+            data += n;
         }
+        return count;
+    } else if (c == 'c') {  // '%c', read char
+        const char ch = (char)arg_u32(args);
+        return out->write(state, &ch, 1) ? 1 : EOF;
+    } else if (is_float_conv(c)) {
+        return emit_float(out, state, flags, pad_width,
+                          flags.prec ? (int32_t)precision : -1,
+                          arg_double(args));
+    }
 
-        // value_str points to either %s string or text representation, get it
-        // length
-        size_t value_len = strlen(value_str);
+    uint64_t v;
+    if (flags.bit64) {
+        v = arg_u64(args);
+    } else {
+        v = arg_u32(args);
+        if (flags.bit16) v = v & 0xffff;
+        if (flags.bit8) v = v & 0xff;
+    }
+    return emit_int(out, state, flags, pad_width, precision, v);
+}
 
-        // Adjust value len to requested precision
-        if (precision && value_len > precision) value_len = precision;
+// Output formatted text, return number of characters written or EOF. Invalid
+// conversions are printed as ERROR_STR, unless `strict` is set, in which case
+// FORMAT_ERROR is returned.
+static int format_args(const struct sink *out, void *state, const char *format,
+                       struct args *args, bool strict) {
+    int count = 0;  // Counter for output characters
 
-        // If precision is zero, print everything
-        if (!precision)
-            precision = (value_len > pad_width) ? value_len : pad_width;
+    if (!format) return EOF;
 
-        // Padding right if requested
-        if (flags.left == 0) {
-            const char pad_char = flags.pad_zero ? '0' : ' ';
-            while (value_len < pad_width) {
-                if (!write(state, pad_char)) return EOF;
-                count++;
-                value_len++;
-            }
+    while (*format) {
+        // Literal text up to the next specifier
+        const size_t run = strcspn(format, "%");
+        if (run) {
+            if (!out->write(state, format, run)) return EOF;
+            count += (int)run;
+            format += run;
+            continue;
         }
 
-        while (*value_str && precision) {
-            if (!write(state, *value_str++)) return EOF;
-            count++;
-            precision--;
+        if (!format[1]) {  // Incomplete format flag
+            if (strict) return FORMAT_ERROR;
+            format = ERROR_STR;
+            continue;
         }
 
-        // Padding left if requested
-        if (flags.left)
-            while (value_len < pad_width) {
-                if (!write(state, ' ')) return EOF;
-                count++;
-                value_len++;
-            }
+        struct spec sp;
+        format = parse_spec(format + 1, &sp);
+        const int n = convert(out, state, &sp, args);
+        if (n == EOF) return EOF;
+        if (n == FORMAT_ERROR) {
+            // Unrecognized / unsupported format
+            if (strict) return FORMAT_ERROR;
+            format = ERROR_STR;
+            continue;
+        }
+        count += n;
     }
     return count;
 }
 
-struct printf_state {
-    size_t len;
-    char buf[PRINTF_BUFFER_SIZE];
+static int formatter(const struct sink *out, void *state, const char *format,
+                     va_list args) {
+    va_list ap;
+    va_copy(ap, args);
+    struct args a = {.ap = &ap};
+    const int res = format_args(out, state, format, &a, false);
+    va_end(ap);
+    return res;
+}
+
+// Compiled formats keep struct fmt as a plain word
+union fmt_word {
+    struct fmt flags;
+    uint32_t word;
 };
 
-static bool write_printf(void *state, int c) {
-    struct printf_state *ctx = (struct printf_state *)state;
+int printf_compile(const char *format, struct printf_compiled *compiled) {
+    if (!format) return EOF;
 
-    if (ctx->len < sizeof(ctx->buf)) {
-        ctx->buf[ctx->len++] = (char)c;
-    } else {
-        // If buffer is full, print it
-        if (putnstr(ctx->buf, sizeof(ctx->buf)) < 0) return false;
-        ctx->len = 1;
-        ctx->buf[0] = (char)c;
+    const char *literal = format;
+    compiled->format = format;
+    compiled->count = 0;
+    while (true) {
+        const char *end = literal + strcspn(literal, "%");
+        struct spec sp = {};
+        const char *next = end;
+
+        if (*end) {
+            next = parse_spec(end + 1, &sp);
+            const char c = (char)sp.flags.conv;
+            if (!c || (!strchr("%sHcdupxXob", c) && !is_float_conv(c)))
+                return EOF;
+            if (sp.width > MAX_FORMAT || sp.precision > MAX_FORMAT)
+                return EOF;
+            if (c == 'H' && !sp.precision && !sp.flags.prec_arg) return EOF;
+        } else if (end == literal) {
+            break;
+        }
+        if (compiled->count == PRINTF_COMPILED_OPS ||
+            (size_t)(end - format) > UINT16_MAX)
+            return EOF;
+
+        const union fmt_word spec = {.flags = sp.flags};
+        compiled->op[compiled->count++] = (struct printf_op){
+            .literal = (uint16_t)(literal - format),
+            .literal_len = (uint16_t)(end - literal),
+            .spec = spec.word,
+            .width = (uint16_t)sp.width,
+            .precision = (uint16_t)sp.precision};
+        if (!*end) break;
+        literal = next;
     }
-    return true;
+    return 0;
+}
+
+static int format_compiled(const struct sink *out, void *state,
+                           const struct printf_compiled *compiled,
+                           va_list *ap) {
+    struct args a = {.ap = ap}, *args = &a;
+    int count = 0;
+
+    for (size_t i = 0; i < compiled->count; i++) {
+        const struct printf_op *op = &compiled->op[i];
+        if (op->literal_len) {
+            if (!out->write(state, compiled->format + op->literal,
+                            op->literal_len))
+                return EOF;
+            count += op->literal_len;
+        }
+        if (!op->spec) continue;
+
+        const union fmt_word spec = {.word = op->spec};
+        const struct spec sp = {.flags = spec.flags,
+                                .width = op->width,
+                                .precision = op->precision};
+        const int n = convert(out, state, &sp, args);
+        if (n == EOF) return EOF;
+        if (n == FORMAT_ERROR) {
+            if (!out->write(state, ERROR_STR, sizeof(ERROR_STR) - 1))
+                return EOF;
+            return count + (int)sizeof(ERROR_STR) - 1;
+        }
+        count += n;
+    }
+    return count;
+}
+
+static bool write_file(void *state, const char *str, size_t len) {
+    return file_write((FILE *)state, str, len);
+}
+
+static bool fill_file(void *state, char c, size_t len) {
+    return file_fill((FILE *)state, c, len);
+}
+
+static const struct sink file_sink = {.write = write_file, .fill = fill_file};
+
+// Flush per buffering mode, or print error message if formatting failed
+static int printf_done(FILE *f, int res) {
+    if (res < 0) file_write(f, ERROR_STR, sizeof(ERROR_STR) - 1);
+    return file_done(f, res);
 }
 
 int printf(const char *format, ...) {
     va_list args;
-    struct printf_state ctx;
     int res;
-    ctx.len = 0;
 
     va_start(args, format);
-    res = formatter(write_printf, &ctx, format, args);
+    res = formatter(&file_sink, stdout, format, args);
     va_end(args);
-    if (res > 0) {
-        if (ctx.len) res = (int)putnstr(ctx.buf, ctx.len);
-    } else
-        putnstr(ERROR_STR, sizeof(ERROR_STR));
+    return printf_done(stdout, res);
+}
 
-    return res;
+int vfprintf(FILE *restrict stream, const char *restrict format,
+             va_list arg) {
+    return printf_done(stream, formatter(&file_sink, stream, format, arg));
 }
 
-static const char NEWLINE[] = "\n";
+int fprintf(FILE *restrict stream, const char *restrict format, ...) {
+    va_list args;
+    int res;
 
-int puts(const char *str) {
-    if (!str) return EOF;
-    size_t len = strlen(str);
-    int res = (int)putnstr(str, len);
-    if (res >= 0) res = (int)putnstr(NEWLINE, 1);
+    va_start(args, format);
+    res = vfprintf(stream, format, args);
+    va_end(args);
     return res;
 }
 
+int printf_compiled(const struct printf_compiled *compiled, ...) {
+    va_list args;
+    int res;
+
+    va_start(args, compiled);
+    res = format_compiled(&file_sink, stdout, compiled, &args);
+    va_end(args);
+    return printf_done(stdout, res);
+}
+
+// Flags of conversion for print.h value
+static struct fmt print_flags(const struct noc_arg *a, char conv) {
+    struct fmt flags = {.conv = (unsigned char)conv};
+    flags.left = (a->flags & NOC_LEFT) != 0;
+    flags.pad_zero = (a->flags & NOC_ZERO) != 0;
+    flags.prec = (a->flags & NOC_PREC) != 0;
+    return flags;
+}
+
+// Decimal without precision is converted in place in the stream buffer
+static int print_dec(FILE *f, const struct noc_arg *a, uint64_t v,
+                     bool negative) {
+    char digits[UTOA_BUFFER_SIZE];
+    const size_t len = (size_t)(u64toa(v, digits) - digits);
+    const size_t n = len + negative;
+    const size_t pad = (a->width > n) ? a->width - n : 0;
+    size_t avail;
+    char *p = fborrow(f, n + pad, &avail);
+
+    if (!p) return EOF;
+    if (pad && !(a->flags & (NOC_LEFT | NOC_ZERO))) {
+        memset(p, ' ', pad);
+        p += pad;
+    }
+    if (negative) *p++ = '-';
+    if (pad && (a->flags & (NOC_LEFT | NOC_ZERO)) == NOC_ZERO) {
+        memset(p, '0', pad);
+        p += pad;
+    }
+    memcpy(p, digits, len);
+    p += len;
+    if (pad && (a->flags & NOC_LEFT)) memset(p, ' ', pad);
+    f->len += n + pad;
+    return (int)(n + pad);
+}
+
+static int print_int(FILE *f, const struct noc_arg *a, uint64_t v,
+                     bool bit64) {
+    if ((a->conv == 'd' || a->conv == 'u') && !(a->flags & NOC_PREC) &&
+        a->width + (size_t)UTOA_BUFFER_SIZE <= f->size) {
+        const bool negative =
+            a->conv == 'd' && (bit64 ? (int64_t)v < 0 : (int32_t)v < 0);
+        if (negative) v = bit64 ? 0 - v : (uint32_t)(0 - (uint32_t)v);
+        return print_dec(f, a, v, negative);
+    }
+
+    struct fmt flags = print_flags(a, a->conv);
+    flags.bit64 = bit64;
+    return emit_int(&file_sink, f, flags, a->width,
+                    flags.prec ? a->precision : 0, v);
+}
+
+int noc_emit_i32(FILE *f, const struct noc_arg *a) {
+    return print_int(f, a, (uint32_t)a->v.i, false);
+}
+
+int noc_emit_i64(FILE *f, const struct noc_arg *a) {
+    return print_int(f, a, a->v.u, true);
+}
+
+int noc_emit_u32(FILE *f, const struct noc_arg *a) {
+    return print_int(f, a, (uint32_t)a->v.u, false);
+}
+
+int noc_emit_u64(FILE *f, const struct noc_arg *a) {
+    return print_int(f, a, a->v.u, true);
+}
+
+int noc_emit_char(FILE *f, const struct noc_arg *a) {
+    if (a->conv != 'c') return print_int(f, a, (uint8_t)a->v.i, false);
+    const char ch = (char)a->v.i;
+    return emit_padded(&file_sink, f, print_flags(a, 'c'), a->width, &ch, 1);
+}
+
+int noc_emit_str(FILE *f, const struct noc_arg *a) {
+    if (!a->width && !a->flags && a->v.s) {
+        const size_t len = strlen(a->v.s);
+        return file_write(f, a->v.s, len) ? (int)len : EOF;
+    }
+    return emit_str(&file_sink, f, print_flags(a, 's'), a->width,
+                    (a->flags & NOC_PREC) ? a->precision : 0, a->v.s);
+}
+
+int noc_emit_ptr(FILE *f, const struct noc_arg *a) {
+    return print_int(f, a, (uintptr_t)a->v.p,
+                     sizeof(void *) == sizeof(uint64_t));
+}
+
+int noc_emit_double(FILE *f, const struct noc_arg *a) {
+    char conv = a->conv;
+    // Hexadecimal floating point for noc_hex()
+    if (conv == 'x' || conv == 'X')
+        conv = (char)(conv - 'x' + 'a');
+    else if (!is_float_conv(conv))
+        conv = 'g';
+    // Shortest round-trip digits unless precision is set
+    return emit_float(&file_sink, f, print_flags(a, conv), a->width,
+                      (a->flags & NOC_PREC) ? a->precision : DTOA_SHORTEST,
+                      a->v.d);
+}
+
+int noc_fprint_n(FILE *f, const struct noc_arg *args, size_t n) {
+    int count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        const int res = args[i].emit(f, &args[i]);
+        if (res == EOF) return file_done(f, EOF);
+        if (res == FORMAT_ERROR) {
+            if (!file_write(f, ERROR_STR, sizeof(ERROR_STR) - 1))
+                return file_done(f, EOF);
+            return file_done(f, count + (int)sizeof(ERROR_STR) - 1);
+        }
+        count += res;
+    }
+    return file_done(f, count);
+}
+
 // Alias for gcc / FORTIFY_SOURCES>0
 int __printf_chk(const char *format, ...)
     __attribute__((weak, alias("printf")));
@@ -409,14 +784,43 @@ struct snprintf_state {
     char *str;
 };
 
-// Write to null-terminated string
-static bool write_str(void *state, int c) {
+// Write to null-terminated string, only as much as fits
+static bool write_str(void *state, const char *str, size_t len) {
+    struct snprintf_state *ctx = (struct snprintf_state *)state;
+    len = MIN(len, (size_t)(ctx->str_end - ctx->str));
+    memcpy(ctx->str, str, len);
+    ctx->str += len;
+    return true;
+}
+
+static bool fill_str(void *state, char c, size_t len) {
     struct snprintf_state *ctx = (struct snprintf_state *)state;
-    // Write only if there is enough space
-    if (ctx->str < ctx->str_end) *(ctx->str++) = (char)c;
+    len = MIN(len, (size_t)(ctx->str_end - ctx->str));
+    memset(ctx->str, c, len);
+    ctx->str += len;
+    return true;
+}
+
+static const struct sink str_sink = {.write = write_str, .fill = fill_str};
+
+// Sizing only, for snprintf(NULL, 0, ...)
+static bool write_none(void *state, const char *str, size_t len) {
+    (void)state;
+    (void)str;
+    (void)len;
+    return true;
+}
+
+static bool fill_none(void *state, char c, size_t len) {
+    (void)state;
+    (void)c;
+    (void)len;
     return true;
 }
 
+static const struct sink count_sink = {.write = write_none,
+                                       .fill = fill_none};
+
 // The functions snprintf() and vsnprintf() do not write more than size bytes
 // (including the terminating null byte ('\0')). If the output was truncated
 // due to this limit, then the return value is the number of characters
@@ -424,23 +828,210 @@ static bool write_str(void *state, int c) {
 // final string if enough space had been available. Thus, a return value of size
 // or more means that the output was truncated.
 int snprintf(char *restrict str, size_t n, const char *restrict format, ...) {
-    if (n == 0) return -1;
-    struct snprintf_state ctx = {.str_end = str + n - 1, .str = str};
     va_list args;
     va_start(args, format);
-    int res = formatter(write_str, &ctx, format, args);
+    int res = vsnprintf(str, n, format, args);
     va_end(args);
-    *ctx.str_end = 0;
-    *ctx.str = 0;
     return res;
 }
 
 int vsnprintf(char *restrict str, size_t n, const char *restrict format,
               va_list args) {
-    if (n == 0) return -1;
+    if (n == 0) return formatter(&count_sink, NULL, format, args);
     struct snprintf_state ctx = {.str_end = str + n - 1, .str = str};
-    int res = formatter(write_str, &ctx, format, args);
+    int res = formatter(&str_sink, &ctx, format, args);
     *ctx.str_end = 0;
     *ctx.str = 0;
     return res;
 }
+
+int snprintf_compiled(char *restrict str, size_t n,
+                      const struct printf_compiled *compiled, ...) {
+    va_list args;
+    va_start(args, compiled);
+    int res = vsnprintf_compiled(str, n, compiled, args);
+    va_end(args);
+    return res;
+}
+
+int vsnprintf_compiled(char *restrict str, size_t n,
+                       const struct printf_compiled *compiled, va_list args) {
+    struct snprintf_state ctx = {.str_end = n ? str + n - 1 : str, .str = str};
+    va_list ap;
+    va_copy(ap, args);
+    int res = format_compiled(n ? &str_sink : &count_sink, &ctx, compiled, &ap);
+    va_end(ap);
+    if (n == 0) return res;
+    *ctx.str_end = 0;
+    *ctx.str = 0;
+    return res;
+}
+
+static bool write_strbuf(void *state, const char *str, size_t len) {
+    return strbuf_append((struct strbuf *)state, str, len) == 0;
+}
+
+static bool fill_strbuf(void *state, char c, size_t len) {
+    struct strbuf *sb = (struct strbuf *)state;
+    char *p = strbuf_reserve(sb, len);
+    if (!p) return false;
+    memset(p, c, len);
+    strbuf_commit(sb, len);
+    return true;
+}
+
+static const struct sink strbuf_sink = {.write = write_strbuf,
+                                        .fill = fill_strbuf};
+
+int strbuf_vprintf(struct strbuf *restrict sb, const char *restrict format,
+                   va_list arg) {
+    const size_t len = sb->len;
+    va_list ap;
+    va_copy(ap, arg);
+    struct args a = {.ap = &ap};
+    const int res = format_args(&strbuf_sink, sb, format, &a, true);
+    va_end(ap);
+    if (res < 0) {
+        // Drop partial output
+        if (sb->buf) {
+            sb->len = len;
+            sb->buf[len] = 0;
+        }
+        return EOF;
+    }
+    return res;
+}
+
+int strbuf_printf(struct strbuf *restrict sb, const char *restrict format,
+                  ...) {
+    va_list args;
+    va_start(args, format);
+    const int res = strbuf_vprintf(sb, format, args);
+    va_end(args);
+    return res;
+}
+
+int vasprintf(char **restrict strp, const char *restrict format,
+              va_list arg) {
+    struct strbuf sb = STRBUF_INIT;
+    // Allocated even for empty output
+    int res = strbuf_reserve(&sb, 0) ? strbuf_vprintf(&sb, format, arg) : EOF;
+    if (res < 0) strbuf_free(&sb);
+    *strp = sb.buf;
+    return res;
+}
+
+int asprintf(char **restrict strp, const char *restrict format, ...) {
+    va_list args;
+    va_start(args, format);
+    const int res = vasprintf(strp, format, args);
+    va_end(args);
+    return res;
+}
+
+// Append `len` bytes and `extra` zero bytes to record, padded to 4 bytes
+static inline __attribute__((always_inline)) uint8_t *rec_put(
+    uint8_t *p, const uint8_t *end, const void *src, size_t len,
+    size_t extra) {
+    const size_t slot = (len + extra + 3) & ~(size_t)3;
+    if (!p || (size_t)(end - p) < slot) return NULL;
+    // Inlined for constant sizes of numbers
+    __builtin_memcpy(p, src, len);
+    __builtin_memset(p + len, 0, slot - len);
+    return p + slot;
+}
+
+// Record: header word with size of record in bits 0-15 and size of format
+// address in bits 16-23, format address, then arguments in 4-byte slots in
+// the order of conversions.
+intptr_t dlog_encode(void *dest, size_t size, const char *format,
+                     va_list args) {
+    uint8_t *const start = (uint8_t *)dest;
+    const uint8_t *end = start + MIN(size, (size_t)UINT16_MAX & ~(size_t)3);
+    const uintptr_t addr = (uintptr_t)format;
+    va_list ap;
+
+    if (!format || size < sizeof(uint32_t)) return -1;
+    uint8_t *p = rec_put(start + sizeof(uint32_t), end, &addr, sizeof(addr), 0);
+
+    va_copy(ap, args);
+    while (p && (format = strchr(format, '%'))) {
+        struct spec sp;
+        const char *str;
+
+        if (!format[1]) {  // Incomplete format flag
+            p = NULL;
+            break;
+        }
+        format = parse_spec(format + 1, &sp);
+
+        uint32_t precision = sp.precision;
+        if (sp.flags.width_arg) {
+            const int v = va_arg(ap, int);
+            p = rec_put(p, end, &v, sizeof(v), 0);
+        }
+        if (sp.flags.prec_arg) {
+            const int v = va_arg(ap, int);
+            precision = (v < 0) ? 0 : (uint32_t)v;
+            p = rec_put(p, end, &v, sizeof(v), 0);
+        }
+
+        const char c = (char)sp.flags.conv;
+        if (c == '%') {
+            continue;
+        } else if (c == 's') {
+            // Copy of the string, as much as will be printed
+            str = va_arg(ap, const char *);
+            if (!str) str = "[null]";
+            const size_t max = sp.flags.prec
+                                   ? MIN(precision, (uint32_t)DLOG_MAX_STRING)
+                                   : DLOG_MAX_STRING;
+            p = rec_put(p, end, str, strnlen(str, max), 1);
+        } else if (c == 'H') {
+            str = va_arg(ap, const char *);
+            p = (str && precision) ? rec_put(p, end, str, precision, 0) : NULL;
+        } else if (c == 'c') {
+            const int v = va_arg(ap, int);
+            p = rec_put(p, end, &v, sizeof(v), 0);
+        } else if (is_float_conv(c)) {
+            const double v = va_arg(ap, double);
+            p = rec_put(p, end, &v, sizeof(v), 0);
+        } else if (c && strchr("duxXobp", c)) {
+            if (sp.flags.bit64) {
+                const uint64_t v = va_arg(ap, uint64_t);
+                p = rec_put(p, end, &v, sizeof(v), 0);
+            } else {
+                const uint32_t v = va_arg(ap, uint32_t);
+                p = rec_put(p, end, &v, sizeof(v), 0);
+            }
+        } else {
+            p = NULL;
+        }
+    }
+    va_end(ap);
+    if (!p) return -1;
+
+    const uint32_t header = (uint32_t)(p - start) | (sizeof(addr) << 16);
+    memcpy(start, &header, sizeof(header));
+    return p - start;
+}
+
+int dlog_snprintf(char *restrict str, size_t n, const char *format,
+                  const struct dlog_record *rec) {
+    struct snprintf_state ctx = {.str_end = n ? str + n - 1 : str, .str = str};
+    struct args a = {.rec = rec->args,
+                     .end = (const uint8_t *)rec->args + rec->args_len};
+    int res =
+        format_args(n ? &str_sink : &count_sink, &ctx, format, &a, false);
+    if (n == 0) return res;
+    *ctx.str_end = 0;
+    *ctx.str = 0;
+    return res;
+}
+
+int dlog_printf(const char *format, const struct dlog_record *rec) {
+    struct args a = {.rec = rec->args,
+                     .end = (const uint8_t *)rec->args + rec->args_len};
+    return printf_done(stdout,
+                       format_args(&file_sink, stdout, format, &a, false));
+}
@@ -0,0 +1,171 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <noc_internal/common.h>
+#include <noc_internal/stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Stream flags: a new-line was buffered, a write failed
+#define FILE_NEWLINE 1
+#define FILE_ERROR 2
+
+static intptr_t write_stdout(void *cookie, const char *buf, size_t len) {
+    (void)cookie;
+    return putnstr(buf, len) < 0 ? -1 : (intptr_t)len;
+}
+
+static const struct file_ops stdout_ops = {.write = write_stdout};
+static char stdout_buf[BUFSIZ];
+static FILE stdout_file =
+    FILE_INIT(&stdout_ops, NULL, stdout_buf, sizeof(stdout_buf), _IOLBF);
+FILE *const stdout = &stdout_file;
+
+// Write all of `str` to the device, which may take partial writes
+static bool file_out(FILE *f, const char *str, size_t len) {
+    while (len) {
+        const intptr_t n = f->ops->write ? f->ops->write(f->cookie, str, len)
+                                         : -1;
+        if (n <= 0) {
+            f->flags |= FILE_ERROR;
+            return false;
+        }
+        str += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static bool file_flush(FILE *f) {
+    const size_t len = f->len;
+    f->len = 0;
+    f->flags &= ~FILE_NEWLINE;
+    return !len || file_out(f, f->buf, len);
+}
+
+bool file_write(FILE *f, const char *str, size_t len) {
+    if (f->mode == _IOLBF && memchr(str, '\n', len)) f->flags |= FILE_NEWLINE;
+    if (f->len + len > f->size) {
+        if (!file_flush(f)) return false;
+        // Long spans are written directly
+        if (len > f->size) return file_out(f, str, len);
+    }
+    memcpy(f->buf + f->len, str, len);
+    f->len += len;
+    return true;
+}
+
+bool file_fill(FILE *f, char c, size_t len) {
+    if (f->mode == _IOLBF && c == '\n' && len) f->flags |= FILE_NEWLINE;
+    if (!f->size) {
+        // No buffer, write in small chunks
+        char chunk[16];
+        memset(chunk, c, sizeof(chunk));
+        for (size_t n; len; len -= n) {
+            n = MIN(len, sizeof(chunk));
+            if (!file_out(f, chunk, n)) return false;
+        }
+        return true;
+    }
+    while (len) {
+        if (f->len == f->size && !file_flush(f)) return false;
+        const size_t n = MIN(len, f->size - f->len);
+        memset(f->buf + f->len, c, n);
+        f->len += n;
+        len -= n;
+    }
+    return true;
+}
+
+int file_done(FILE *f, int res) {
+    if ((f->mode == _IONBF || (f->flags & FILE_NEWLINE)) && !file_flush(f))
+        return EOF;
+    return res;
+}
+
+int setvbuf(FILE *restrict stream, char *restrict buf, int mode, size_t size) {
+    if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF) return EOF;
+    if (!file_flush(stream)) return EOF;
+    if (buf && size) {
+        stream->buf = buf;
+        stream->size = size;
+    }
+    stream->mode = mode;
+    return 0;
+}
+
+int fflush(FILE *stream) {
+    if (!stream) stream = stdout;
+    return file_flush(stream) ? 0 : EOF;
+}
+
+int putchar(int c) {
+    FILE *f = stdout;
+    const char ch = (char)c;
+
+    if (f->len < f->size) {
+        f->buf[f->len++] = ch;
+        if (ch == '\n' && f->mode == _IOLBF) f->flags |= FILE_NEWLINE;
+    } else if (!file_write(f, &ch, 1)) {
+        return EOF;
+    }
+    return file_done(f, (unsigned char)ch);
+}
+
+int fputs(const char *restrict s, FILE *restrict stream) {
+    if (!file_write(stream, s, strlen(s))) return EOF;
+    return file_done(stream, 0);
+}
+
+size_t fwrite(const void *restrict ptr, size_t size, size_t nmemb,
+              FILE *restrict stream) {
+    if (!size || !nmemb) return 0;
+    if (!file_write(stream, (const char *)ptr, size * nmemb)) return 0;
+    return file_done(stream, 0) == EOF ? 0 : nmemb;
+}
+
+size_t fread(void *restrict ptr, size_t size, size_t nmemb,
+             FILE *restrict stream) {
+    const size_t total = size * nmemb;
+    size_t done = 0;
+
+    if (!total || !stream->ops->read) return 0;
+    while (done < total) {
+        const intptr_t n =
+            stream->ops->read(stream->cookie, (char *)ptr + done, total - done);
+        if (n <= 0) {
+            if (n < 0) stream->flags |= FILE_ERROR;
+            break;
+        }
+        done += (size_t)n;
+    }
+    return done / size;
+}
+
+char *fborrow(FILE *restrict stream, size_t min, size_t *restrict avail) {
+    if (min > stream->size) return NULL;
+    if (stream->size - stream->len < min && !file_flush(stream)) return NULL;
+    *avail = stream->size - stream->len;
+    return stream->buf + stream->len;
+}
+
+int fcommit(FILE *stream, size_t len) {
+    const char *p = stream->buf + stream->len;
+    if (stream->mode == _IOLBF && memchr(p, '\n', len))
+        stream->flags |= FILE_NEWLINE;
+    stream->len += len;
+    return file_done(stream, 0);
+}
+
+int puts(const char *str) {
+    if (!str) return EOF;
+    if (!file_write(stdout, str, strlen(str)) || !file_write(stdout, "\n", 1))
+        return EOF;
+    return file_done(stdout, 0);
+}
@@ -0,0 +1,49 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strbuf.h>
+#include <string.h>
+
+#include "noc_internal/common.h"
+
+char *strbuf_reserve(struct strbuf *sb, size_t len) {
+    const size_t need = sb->len + len + 1;
+
+    if (need < len) return NULL;
+    if (need > sb->size) {
+        // Double the size to keep the amortized cost linear
+        size_t size = MAX(sb->size * 2, (size_t)STRBUF_MIN_SIZE);
+        size = MAX(size, need);
+        char *buf = (char *)realloc(sb->buf, size);
+        if (!buf) return NULL;
+        if (!sb->buf) buf[0] = 0;
+        sb->buf = buf;
+        sb->size = size;
+    }
+    return sb->buf + sb->len;
+}
+
+void strbuf_commit(struct strbuf *sb, size_t len) {
+    sb->len += len;
+    sb->buf[sb->len] = 0;
+}
+
+int strbuf_append(struct strbuf *restrict sb, const char *restrict str,
+                  size_t len) {
+    char *p = strbuf_reserve(sb, len);
+    if (!p) return EOF;
+    memcpy(p, str, len);
+    strbuf_commit(sb, len);
+    return 0;
+}
+
+void strbuf_free(struct strbuf *sb) {
+    free(sb->buf);
+    *sb = (struct strbuf)STRBUF_INIT;
+}
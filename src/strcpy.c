@@ -0,0 +1,126 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "noc_internal/common.h"
+#include "noc_internal/simd.h"
+#include "noc_internal/swar.h"
+
+// Copy `s` to `d` up to and including the first byte `c`, but not more than
+// `n` bytes. The byte is found during the copy, source is read with aligned
+// loads only, which never cross a page. Returns pointer to the copy of `c` in
+// `d`, or `d + n` if there is none in the first `n` bytes.
+#if defined(NOC_SIMD)
+static inline __attribute__((always_inline)) char *copy_until(
+    char *d, const char *s, uint8_t c, size_t n) {
+    const vec_t cv = vec_set1(c);
+
+    // Source bytes up to the vector boundary
+    const uint8_t *a = vec_align_down(s);
+    const size_t skip = (size_t)((const uint8_t *)s - a);
+    size_t len = VEC_SIZE - skip;
+    vec_mask_t m = vec_eq_mask(vec_load(a), cv) >> skip;
+
+    if (!m && len < n) {
+        vec_move_short(d, s, len);
+        d += len;
+        s += len;
+        n -= len;
+        for (;;) {
+            const vec_t v = vec_load(s);
+            m = vec_eq_mask(v, cv);
+            if (m || n <= VEC_SIZE) break;
+            vec_storeu(d, v);
+            d += VEC_SIZE;
+            s += VEC_SIZE;
+            n -= VEC_SIZE;
+        }
+    }
+    if (m) {
+        len = stdc_trailing_zerosui(m) + 1;
+        if (len <= n) {
+            vec_move_short(d, s, len);
+            return d + len - 1;
+        }
+    }
+    // No byte `c` in the first `n` bytes, all in the current vector
+    vec_move_short(d, s, n);
+    return d + n;
+}
+#else
+static inline __attribute__((always_inline)) char *copy_until(
+    char *d, const char *s, uint8_t c, size_t n) {
+    // Copy bytes until source is aligned
+    for (; n && ((uintptr_t)s & SWAR_MASK); d++, s++, n--)
+        if ((uint8_t)(*d = *s) == c) return d;
+
+    // Word stores need equal alignment
+    if (!((uintptr_t)d & SWAR_MASK)) {
+        const uintptr_t cc = swar_repeat(c);
+        for (; n >= sizeof(uintptr_t); n -= sizeof(uintptr_t)) {
+            const uintptr_t w = *(const uintptr_t *)(const void *)s;
+            if (swar_has_zero(w ^ cc)) break;
+            *(uintptr_t *)(void *)d = w;
+            d += sizeof(uintptr_t);
+            s += sizeof(uintptr_t);
+        }
+    }
+
+    for (; n; d++, s++, n--)
+        if ((uint8_t)(*d = *s) == c) return d;
+    return d;
+}
+#endif
+
+// Copy string up to and including the null character, see copy_until()
+static char *copy_str(char *d, const char *s, size_t n) {
+    return copy_until(d, s, 0, n);
+}
+
+char *stpcpy(char *restrict dest, const char *restrict src) {
+    return copy_str(dest, src, SIZE_MAX);
+}
+
+char *strcpy(char *restrict dest, const char *restrict src) {
+    copy_str(dest, src, SIZE_MAX);
+    return dest;
+}
+
+char *strncpy(char *restrict dest, const char *restrict src, size_t len) {
+    char *end = copy_str(dest, src, len);
+    // Pad with null characters up to `len`
+    memset(end, 0, (size_t)(dest + len - end));
+    return dest;
+}
+
+char *strzcpy(char *restrict dest, const char *restrict src, size_t len) {
+    if (!len) return dest;
+    *copy_str(dest, src, len - 1) = 0;
+    return dest;
+}
+
+char *strcat(char *restrict s1, const char *restrict s2) {
+    copy_str(s1 + strlen(s1), s2, SIZE_MAX);
+    return s1;
+}
+
+char *strncat(char *restrict s1, const char *restrict s2, size_t len) {
+    *copy_str(s1 + strlen(s1), s2, len) = 0;
+    return s1;
+}
+
+void *mempcpy(void *restrict dest, const void *restrict src, size_t len) {
+    return (uint8_t *)memcpy(dest, src, len) + len;
+}
+
+void *memccpy(void *restrict dest, const void *restrict src, int c,
+              size_t len) {
+    char *end = copy_until(dest, src, (uint8_t)c, len);
+    return (end < (char *)dest + len) ? end + 1 : NULL;
+}
@@ -4,123 +4,577 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT.
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
 #include "noc_internal/common.h"
+#include "noc_internal/simd.h"
+#include "noc_internal/swar.h"
 
-#if defined(ARCH_X86_64)
+#if defined(NOC_SIMD)
 size_t strlen(const char *s) {
-    size_t ret;
-    __asm__(
-        "xor %%rax, %%rax\n"
-        "testq %%rdi, %%rdi\n"
-        "jz 1f\n"
-        "dec %%rax\n"
-        ".align 16\n"
-        "2: \n"
-        "leaq 1(%%rax), %%rax\n"
-        "cmpb $0, (%%rdi, %%rax)\n"
-        "jne 2b\n"
-        "1:\n"
-        : "=a"(ret)
-        : "D"(s)
-        :);
-    return ret;
+    if (s == NULL) return 0;
+    const uint8_t *const start = (const uint8_t *)s;
+    const vec_t zero = vec_zero();
+
+    // Aligned loads never cross a page, skip bytes before the string.
+    const uint8_t *a = vec_align_down(start);
+    vec_mask_t m = vec_eq_mask(vec_load(a), zero) >> (start - a);
+    if (m) return stdc_trailing_zerosui(m);
+
+    // Check vectors one by one up to 4 * VEC_SIZE alignment, so that the
+    // unrolled loop never touches the next page before finding NUL.
+    for (a += VEC_SIZE; (uintptr_t)a & (4 * VEC_SIZE - 1); a += VEC_SIZE) {
+        m = vec_eq_mask(vec_load(a), zero);
+        if (m) return (size_t)(a - start) + stdc_trailing_zerosui(m);
+    }
+    // Minimum of bytes is zero if any of them is zero
+    for (;; a += 4 * VEC_SIZE) {
+        vec_t v = vec_min(vec_min(vec_load(a), vec_load(a + VEC_SIZE)),
+                          vec_min(vec_load(a + 2 * VEC_SIZE),
+                                  vec_load(a + 3 * VEC_SIZE)));
+        if (vec_eq_mask(v, zero)) break;
+    }
+    for (;; a += VEC_SIZE) {
+        m = vec_eq_mask(vec_load(a), zero);
+        if (m) return (size_t)(a - start) + stdc_trailing_zerosui(m);
+    }
 }
 #else
 size_t strlen(const char *s) {
     if (s == NULL) return 0;
-    const char *scan = s;
-    while (*scan) scan++;
-    return (size_t)(scan - s);
+
+    // Aligned loads never cross a page, set bytes before the string non-zero.
+    const uintptr_t *w = (const uintptr_t *)((uintptr_t)s & ~SWAR_MASK);
+    uintptr_t z = swar_has_zero(*w | swar_mask_below((uintptr_t)s & SWAR_MASK));
+    while (!z) z = swar_has_zero(*++w);
+    return (size_t)((const char *)w - s) + swar_first_byte(z);
 }
 #endif
 
-char *strzcpy(char *dest, const char *src, size_t len) {
-    char *d = dest;
-    if (!len) return dest;
-    while (len > 1 && *src) {
-        *(d++) = *(src++);
-        len--;
+// memchr() and memrchr() only use aligned loads, which never cross a page
+// boundary, so they can read past the buffer ends without faulting. Matches
+// outside of the buffer are masked out.
+#if defined(NOC_SIMD)
+const void *memchr(const void *buffer, int c, size_t n) {
+    const uint8_t *p = (const uint8_t *)buffer;
+    if (!n) return NULL;
+    // Adjust n to avoid address wrapping
+    n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)buffer);
+    const uint8_t *const end = p + n;
+    const vec_t cv = vec_set1((uint8_t)c);
+
+    // Skip matches before the buffer
+    const uint8_t *a = vec_align_down(p);
+    vec_mask_t m = vec_eq_mask(vec_load(a), cv) >> (p - a);
+    if (m) {
+        p += stdc_trailing_zerosui(m);
+        return (p < end) ? p : NULL;
+    }
+
+    // Check vectors one by one up to 4 * VEC_SIZE alignment, so that the
+    // unrolled loop never touches the next page after the match.
+    for (a += VEC_SIZE; ((uintptr_t)a & (4 * VEC_SIZE - 1)) && a < end;
+         a += VEC_SIZE) {
+        m = vec_eq_mask(vec_load(a), cv);
+        if (m) {
+            a += stdc_trailing_zerosui(m);
+            return (a < end) ? a : NULL;
+        }
+    }
+    // Check 4 vectors at once, locate the match afterwards
+    for (; a + 4 * VEC_SIZE <= end; a += 4 * VEC_SIZE) {
+        vec_t e0 = vec_cmpeq(vec_load(a), cv);
+        vec_t e1 = vec_cmpeq(vec_load(a + VEC_SIZE), cv);
+        vec_t e2 = vec_cmpeq(vec_load(a + 2 * VEC_SIZE), cv);
+        vec_t e3 = vec_cmpeq(vec_load(a + 3 * VEC_SIZE), cv);
+        if (vec_movemask(vec_or(vec_or(e0, e1), vec_or(e2, e3)))) break;
+    }
+    for (; a < end; a += VEC_SIZE) {
+        m = vec_eq_mask(vec_load(a), cv);
+        if (m) {
+            a += stdc_trailing_zerosui(m);
+            return (a < end) ? a : NULL;
+        }
     }
-    *d = 0;
-    return dest;
+    return NULL;
 }
 
+const void *memrchr(const void *buffer, int c, size_t n) {
+    const uint8_t *p = (const uint8_t *)buffer;
+    if (!n) return NULL;
+    // Adjust n to avoid address wrapping
+    n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)buffer);
+    const uint8_t *const end = p + n;
+    const vec_t cv = vec_set1((uint8_t)c);
+
+    // Skip matches after the buffer
+    const uint8_t *a = vec_align_down(end - 1);
+    vec_mask_t m =
+        vec_eq_mask(vec_load(a), cv) & vec_mask_below((size_t)(end - a));
+    while (a > p) {
+        if (m) return a + 31 - stdc_leading_zerosui(m);
+        a -= VEC_SIZE;
+        m = vec_eq_mask(vec_load(a), cv);
+    }
+    // Skip matches before the buffer
+    m &= ~vec_mask_below((size_t)(p - a));
+    return (m) ? a + 31 - stdc_leading_zerosui(m) : NULL;
+}
+#else
 const void *memchr(const void *buffer, int c, size_t n) {
-    const char *current = (char *)buffer;
+    const uint8_t *p = (const uint8_t *)buffer;
+    if (!n) return NULL;
+    // Adjust n to avoid address wrapping
+    n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)buffer);
+    const uint8_t *const end = p + n;
+    const uintptr_t cc = swar_repeat((uint8_t)c);
+
+    // Matching bytes become zero. Set bytes before the buffer to non-zero.
+    const uintptr_t *w = (const uintptr_t *)((uintptr_t)p & ~SWAR_MASK);
+    uintptr_t z =
+        swar_has_zero((*w ^ cc) | swar_mask_below((uintptr_t)p & SWAR_MASK));
+    while (!z) {
+        w++;
+        if ((const uint8_t *)w >= end) return NULL;
+        z = swar_has_zero(*w ^ cc);
+    }
+    p = (const uint8_t *)w + swar_first_byte(z);
+    return (p < end) ? p : NULL;
+}
+
+const void *memrchr(const void *buffer, int c, size_t n) {
+    const uint8_t *p = (const uint8_t *)buffer;
+    if (!n) return NULL;
     // Adjust n to avoid address wrapping
     n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)buffer);
-    const char *end = current + n;
-    while (current < end) {
-        if (*current == c) return current;
-        current++;
+    const uint8_t *const end = p + n;
+    const uintptr_t cc = swar_repeat((uint8_t)c);
+
+    // Exact zero byte check, as we need the last match.
+    const uintptr_t *w = (const uintptr_t *)((uintptr_t)(end - 1) & ~SWAR_MASK);
+    uintptr_t z = swar_zero_bytes(*w ^ cc);
+    // Skip matches after the buffer
+    const size_t tail = (size_t)(end - (const uint8_t *)w);
+    if (tail < sizeof(uintptr_t)) z &= swar_mask_below(tail);
+    while ((const uint8_t *)w > p) {
+        if (z) return (const uint8_t *)w + swar_last_byte(z);
+        w--;
+        z = swar_zero_bytes(*w ^ cc);
+    }
+    // Skip matches before the buffer
+    z &= ~swar_mask_below((size_t)(p - (const uint8_t *)w));
+    return (z) ? (const uint8_t *)w + swar_last_byte(z) : NULL;
+}
+#endif
+
+// memchr2() and memchr3() find the first of several bytes in a single pass.
+// memchr2() repeats one of the bytes, which costs less than a separate loop.
+#if defined(NOC_SIMD)
+static inline vec_t match3(vec_t v, vec_t c0, vec_t c1, vec_t c2) {
+    return vec_or(vec_or(vec_cmpeq(v, c0), vec_cmpeq(v, c1)),
+                  vec_cmpeq(v, c2));
+}
+
+static const uint8_t *memchr3_kernel(const uint8_t *p, size_t n, uint8_t c0,
+                                     uint8_t c1, uint8_t c2) {
+    if (!n) return NULL;
+    // Adjust n to avoid address wrapping
+    n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)p);
+    const uint8_t *const end = p + n;
+    const vec_t v0 = vec_set1(c0), v1 = vec_set1(c1), v2 = vec_set1(c2);
+
+    // Skip matches before the buffer
+    const uint8_t *a = vec_align_down(p);
+    vec_mask_t m = vec_movemask(match3(vec_load(a), v0, v1, v2)) >> (p - a);
+    if (m) {
+        p += stdc_trailing_zerosui(m);
+        return (p < end) ? p : NULL;
+    }
+
+    // Single vector up to 2 * VEC_SIZE alignment, so that the unrolled loop
+    // never touches the next page after the match.
+    a += VEC_SIZE;
+    if (((uintptr_t)a & VEC_SIZE) && a < end) {
+        m = vec_movemask(match3(vec_load(a), v0, v1, v2));
+        if (m) {
+            a += stdc_trailing_zerosui(m);
+            return (a < end) ? a : NULL;
+        }
+        a += VEC_SIZE;
+    }
+    // Check 2 vectors at once, locate the match afterwards
+    for (; a + 2 * VEC_SIZE <= end; a += 2 * VEC_SIZE) {
+        vec_t e0 = match3(vec_load(a), v0, v1, v2);
+        vec_t e1 = match3(vec_load(a + VEC_SIZE), v0, v1, v2);
+        if (vec_movemask(vec_or(e0, e1))) break;
+    }
+    for (; a < end; a += VEC_SIZE) {
+        m = vec_movemask(match3(vec_load(a), v0, v1, v2));
+        if (m) {
+            a += stdc_trailing_zerosui(m);
+            return (a < end) ? a : NULL;
+        }
     }
     return NULL;
 }
+#else
+static const uint8_t *memchr3_kernel(const uint8_t *p, size_t n, uint8_t c0,
+                                     uint8_t c1, uint8_t c2) {
+    if (!n) return NULL;
+    // Adjust n to avoid address wrapping
+    n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)p);
+    const uint8_t *const end = p + n;
+    const uintptr_t cc0 = swar_repeat(c0);
+    const uintptr_t cc1 = swar_repeat(c1);
+    const uintptr_t cc2 = swar_repeat(c2);
+
+    // Matching bytes become zero. Set bytes before the buffer to non-zero.
+    const uintptr_t *w = (const uintptr_t *)((uintptr_t)p & ~SWAR_MASK);
+    const uintptr_t skip = swar_mask_below((uintptr_t)p & SWAR_MASK);
+    uintptr_t z = swar_has_zero((*w ^ cc0) | skip) |
+                  swar_has_zero((*w ^ cc1) | skip) |
+                  swar_has_zero((*w ^ cc2) | skip);
+    while (!z) {
+        w++;
+        if ((const uint8_t *)w >= end) return NULL;
+        z = swar_has_zero(*w ^ cc0) | swar_has_zero(*w ^ cc1) |
+            swar_has_zero(*w ^ cc2);
+    }
+    p = (const uint8_t *)w + swar_first_byte(z);
+    return (p < end) ? p : NULL;
+}
+#endif
+
+const void *memchr2(const void *buffer, int c1, int c2, size_t n) {
+    return memchr3_kernel((const uint8_t *)buffer, n, (uint8_t)c1,
+                          (uint8_t)c2, (uint8_t)c2);
+}
+
+const void *memchr3(const void *buffer, int c1, int c2, int c3, size_t n) {
+    return memchr3_kernel((const uint8_t *)buffer, n, (uint8_t)c1,
+                          (uint8_t)c2, (uint8_t)c3);
+}
+
+// strchr() and strrchr() stop at the terminating null character, found in the
+// same pass. Aligned loads never cross a page, so can read past it.
+#if defined(NOC_SIMD)
+char *strchr(const char *s, int c) {
+    if (s == NULL) return NULL;
+    const uint8_t *const start = (const uint8_t *)s;
+    const vec_t cv = vec_set1((uint8_t)c);
+    const vec_t zero = vec_zero();
+
+    // Skip bytes before the string
+    const uint8_t *a = vec_align_down(start);
+    vec_t v = vec_load(a);
+    vec_mask_t m =
+        (vec_eq_mask(v, cv) | vec_eq_mask(v, zero)) >> (start - a);
+    if (m) {
+        a = start + stdc_trailing_zerosui(m);
+        return (*a == (uint8_t)c) ? (char *)a : NULL;
+    }
+    for (;;) {
+        a += VEC_SIZE;
+        v = vec_load(a);
+        m = vec_eq_mask(v, cv) | vec_eq_mask(v, zero);
+        if (m) {
+            a += stdc_trailing_zerosui(m);
+            return (*a == (uint8_t)c) ? (char *)a : NULL;
+        }
+    }
+}
+
+char *strrchr(const char *s, int c) {
+    if (s == NULL) return NULL;
+    if ((uint8_t)c == 0) return (char *)s + strlen(s);
+    const uint8_t *const start = (const uint8_t *)s;
+    const vec_t cv = vec_set1((uint8_t)c);
+    const vec_t zero = vec_zero();
+    const uint8_t *last = NULL;
+
+    // Skip bytes before the string
+    const uint8_t *a = vec_align_down(start);
+    vec_mask_t valid = ~vec_mask_below((size_t)(start - a));
+    for (;; a += VEC_SIZE, valid = VEC_MASK_ALL) {
+        const vec_t v = vec_load(a);
+        vec_mask_t m = vec_eq_mask(v, cv) & valid;
+        const vec_mask_t z = vec_eq_mask(v, zero) & valid;
+        // Only keep matches before the null character
+        if (z) m &= z - 1;
+        if (m) last = a + 31 - stdc_leading_zerosui(m);
+        if (z) return (char *)last;
+    }
+}
+#else
+char *strchr(const char *s, int c) {
+    if (s == NULL) return NULL;
+    const uintptr_t cc = swar_repeat((uint8_t)c);
+
+    // Set bytes before the string to non-zero and not matching
+    const uintptr_t *w = (const uintptr_t *)((uintptr_t)s & ~SWAR_MASK);
+    const uintptr_t skip = swar_mask_below((uintptr_t)s & SWAR_MASK);
+    uintptr_t z = swar_has_zero((*w | skip)) | swar_has_zero((*w ^ cc) | skip);
+    while (!z) {
+        w++;
+        z = swar_has_zero(*w) | swar_has_zero(*w ^ cc);
+    }
+    const uint8_t *p = (const uint8_t *)w + swar_first_byte(z);
+    return (*p == (uint8_t)c) ? (char *)p : NULL;
+}
+
+char *strrchr(const char *s, int c) {
+    if (s == NULL) return NULL;
+    if ((uint8_t)c == 0) return (char *)s + strlen(s);
+    const uintptr_t cc = swar_repeat((uint8_t)c);
+    const uint8_t *last = NULL;
+
+    // Set bytes before the string to non-zero and not matching
+    const uintptr_t *w = (const uintptr_t *)((uintptr_t)s & ~SWAR_MASK);
+    const uintptr_t skip = swar_mask_below((uintptr_t)s & SWAR_MASK);
+    uintptr_t x = *w | skip;
+    uintptr_t m = swar_zero_bytes((*w ^ cc) | skip);
+    for (;; x = *++w, m = swar_zero_bytes(x ^ cc)) {
+        const uintptr_t z = swar_has_zero(x);
+        // Only keep matches before the null character
+        if (z) m &= swar_mask_below(swar_first_byte(z));
+        if (m) last = (const uint8_t *)w + swar_last_byte(m);
+        if (z) return (char *)last;
+    }
+}
+#endif
 
 size_t strnlen(const char *str, size_t maxlen) {
     const char *p = memchr(str, 0, maxlen);
     return (p) ? (size_t)(p - str) : maxlen;
 }
 
-const void *memrchr(const void *buffer, int c, size_t n) {
-    const char *start = (char *)buffer;
-    // Adjust n to avoid address wrapping
-    n = MIN(n, PLATFORM_MAX_ADDR - (uintptr_t)buffer);
-    const char *current = start + n;
-    while (current > start) {
-        current--;
-        if (*current == c) return current;
+#if defined(NOC_SIMD)
+// Compare `len` <= VEC_SIZE bytes when a vector load may cross a page.
+static int memcmp_bytes(const uint8_t *sa, const uint8_t *sb, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        if (sa[i] != sb[i]) return (int)sa[i] - (int)sb[i];
+    return 0;
+}
+
+// Compare vectors at `sa` and `sb`, return true and set `diff` if mismatch.
+static inline bool memcmp_vec(const uint8_t *sa, const uint8_t *sb,
+                              int *diff) {
+    vec_mask_t ne = ~vec_eq_mask(vec_loadu(sa), vec_loadu(sb)) & VEC_MASK_ALL;
+    if (!ne) return false;
+    const uint32_t i = stdc_trailing_zerosui(ne);
+    *diff = (int)sa[i] - (int)sb[i];
+    return true;
+}
+
+static int memcmp_kernel(const uint8_t *sa, const uint8_t *sb, size_t len) {
+    int diff = 0;
+
+    if (len <= VEC_SIZE) {
+        if (!vec_page_safe(sa) || !vec_page_safe(sb))
+            return memcmp_bytes(sa, sb, len);
+        // Read whole vector, but ignore mismatches beyond `len`
+        vec_mask_t ne =
+            ~vec_eq_mask(vec_loadu(sa), vec_loadu(sb)) & VEC_MASK_ALL;
+        const uint32_t i = stdc_trailing_zerosui(ne);
+        return (i < len) ? (int)sa[i] - (int)sb[i] : 0;
     }
-    return NULL;
+
+    // Check 4 vectors at once, locate the mismatch afterwards
+    while (len > 4 * VEC_SIZE) {
+        vec_t eq = vec_and(
+            vec_and(vec_cmpeq(vec_loadu(sa), vec_loadu(sb)),
+                    vec_cmpeq(vec_loadu(sa + VEC_SIZE),
+                              vec_loadu(sb + VEC_SIZE))),
+            vec_and(vec_cmpeq(vec_loadu(sa + 2 * VEC_SIZE),
+                              vec_loadu(sb + 2 * VEC_SIZE)),
+                    vec_cmpeq(vec_loadu(sa + 3 * VEC_SIZE),
+                              vec_loadu(sb + 3 * VEC_SIZE))));
+        if (vec_movemask(eq) != VEC_MASK_ALL) break;
+        sa += 4 * VEC_SIZE;
+        sb += 4 * VEC_SIZE;
+        len -= 4 * VEC_SIZE;
+    }
+    while (len > VEC_SIZE) {
+        if (memcmp_vec(sa, sb, &diff)) return diff;
+        sa += VEC_SIZE;
+        sb += VEC_SIZE;
+        len -= VEC_SIZE;
+    }
+    // Last vector overlaps with already compared equal bytes
+    memcmp_vec(sa + len - VEC_SIZE, sb + len - VEC_SIZE, &diff);
+    return diff;
 }
 
-int memcmp(const void *s1, const void *s2, size_t len) {
+int memeq(const void *s1, const void *s2, size_t len) {
     const uint8_t *sa = s1;
     const uint8_t *sb = s2;
 
-    if (!len) return 0;
-    if (!sa) return (sb) ? -(int)*sb : 0;
-    if (!sb) return (int)*sa;
-    len = MIN(len, PLATFORM_MAX_ADDR - (uintptr_t)sa);
+    if (len <= VEC_SIZE) return memcmp_kernel(sa, sb, len) == 0;
 
-    const uint8_t *sa_end = sa + len;
-    uint8_t c1, c2;
-    do {
-        c1 = *sa++;
-        c2 = *sb++;
-    } while ((c1 == c2) && sa < sa_end);
-    return (int)c1 - (int)c2;
+    // Accumulate differences, only check them once per 4 vectors
+    while (len > 4 * VEC_SIZE) {
+        vec_t ne = vec_or(
+            vec_or(vec_xor(vec_loadu(sa), vec_loadu(sb)),
+                   vec_xor(vec_loadu(sa + VEC_SIZE),
+                           vec_loadu(sb + VEC_SIZE))),
+            vec_or(vec_xor(vec_loadu(sa + 2 * VEC_SIZE),
+                           vec_loadu(sb + 2 * VEC_SIZE)),
+                   vec_xor(vec_loadu(sa + 3 * VEC_SIZE),
+                           vec_loadu(sb + 3 * VEC_SIZE))));
+        if (!vec_is_zero(ne)) return 0;
+        sa += 4 * VEC_SIZE;
+        sb += 4 * VEC_SIZE;
+        len -= 4 * VEC_SIZE;
+    }
+    vec_t ne = vec_xor(vec_loadu(sa + len - VEC_SIZE),
+                       vec_loadu(sb + len - VEC_SIZE));
+    while (len > VEC_SIZE) {
+        ne = vec_or(ne, vec_xor(vec_loadu(sa), vec_loadu(sb)));
+        sa += VEC_SIZE;
+        sb += VEC_SIZE;
+        len -= VEC_SIZE;
+    }
+    return vec_is_zero(ne);
 }
+#else
+// Compare word at a time if buffers are equally aligned. The first mismatching
+// byte is located in the XOR of words instead of re-reading bytes.
+static int memcmp_kernel(const uint8_t *sa, const uint8_t *sb, size_t len) {
+    if (((uintptr_t)sa & SWAR_MASK) == ((uintptr_t)sb & SWAR_MASK)) {
+        for (; len && ((uintptr_t)sa & SWAR_MASK); len--, sa++, sb++)
+            if (*sa != *sb) return (int)*sa - (int)*sb;
 
-int strcmp(const char *s1, const char *s2) {
-    if (!s1) return (s2) ? -(int)(uint8_t)*s2 : 0;
-    if (!s2) return (int)(uint8_t)*s1;
+        for (; len >= sizeof(uintptr_t); len -= sizeof(uintptr_t)) {
+            const uintptr_t wa = *(const uintptr_t *)(const void *)sa;
+            const uintptr_t wb = *(const uintptr_t *)(const void *)sb;
+            if (wa != wb) {
+                const size_t i = swar_first_byte(wa ^ wb);
+                return (int)swar_byte(wa, i) - (int)swar_byte(wb, i);
+            }
+            sa += sizeof(uintptr_t);
+            sb += sizeof(uintptr_t);
+        }
+    }
+    for (; len; len--, sa++, sb++)
+        if (*sa != *sb) return (int)*sa - (int)*sb;
+    return 0;
+}
+
+int memeq(const void *s1, const void *s2, size_t len) {
+    const uint8_t *sa = s1;
+    const uint8_t *sb = s2;
+    uintptr_t ne = 0;
 
-    uint8_t c1, c2;
-    do {
-        c1 = *s1++;
-        c2 = *s2++;
-    } while ((c1 == c2) && c1);
-    return (int)c1 - (int)c2;
+    if (((uintptr_t)sa & SWAR_MASK) == ((uintptr_t)sb & SWAR_MASK)) {
+        for (; len && ((uintptr_t)sa & SWAR_MASK); len--) ne |= *sa++ ^ *sb++;
+
+        // No need to locate mismatch, so only check once per 4 words
+        for (; len >= 4 * sizeof(uintptr_t); len -= 4 * sizeof(uintptr_t)) {
+            const uintptr_t *wa = (const uintptr_t *)(const void *)sa;
+            const uintptr_t *wb = (const uintptr_t *)(const void *)sb;
+            ne |= (wa[0] ^ wb[0]) | (wa[1] ^ wb[1]) | (wa[2] ^ wb[2]) |
+                  (wa[3] ^ wb[3]);
+            if (ne) return 0;
+            sa += 4 * sizeof(uintptr_t);
+            sb += 4 * sizeof(uintptr_t);
+        }
+    }
+    for (; len; len--) ne |= *sa++ ^ *sb++;
+    return ne == 0;
 }
+#endif
 
-int strncmp(const char *s1, const char *s2, size_t len) {
-    if (!len) return 0;
-    if (!s1) return (s2) ? -(int)(uint8_t)*s2 : 0;
-    if (!s2) return (int)(uint8_t)*s1;
+int memcmp(const void *s1, const void *s2, size_t len) {
+    const uint8_t *sa = s1;
+    const uint8_t *sb = s2;
 
-    len = MIN(len, PLATFORM_MAX_ADDR - (uintptr_t)s1);
-    const char *s1_end = s1 + len;
+    if (__builtin_expect(!sa || !sb, 0)) {
+        if (!len) return 0;
+        if (!sa) return (sb) ? -(int)*sb : 0;
+        return (int)*sa;
+    }
+    if (sa == sb) return 0;
+    return memcmp_kernel(sa, sb, len);
+}
 
-    uint8_t c1, c2;
-    do {
-        c1 = *s1++;
-        c2 = *s2++;
-    } while ((c1 == c2) && c1 && s1 < s1_end);
+#if defined(NOC_SIMD)
+// Compare up to `len` characters a vector at a time. Unaligned loads are only
+// used when neither of them can cross a page, so they can't fault reading past
+// the terminating null character. Otherwise compare VEC_SIZE bytes one by one,
+// which moves both pointers past the page boundary.
+static int strncmp_kernel(const uint8_t *s1, const uint8_t *s2, size_t len) {
+    const vec_t zero = vec_zero();
 
-    return (int)c1 - (int)c2;
+    while (len) {
+        if (vec_page_safe(s1) && vec_page_safe(s2)) {
+            const vec_t v1 = vec_loadu(s1);
+            // Stop at the first mismatch or null character
+            vec_mask_t m =
+                (~vec_eq_mask(v1, vec_loadu(s2)) | vec_eq_mask(v1, zero)) &
+                VEC_MASK_ALL;
+            if (m) {
+                const uint32_t i = stdc_trailing_zerosui(m);
+                return (i < len) ? (int)s1[i] - (int)s2[i] : 0;
+            }
+            if (len <= VEC_SIZE) return 0;
+            s1 += VEC_SIZE;
+            s2 += VEC_SIZE;
+            len -= VEC_SIZE;
+        } else {
+            for (size_t i = VEC_SIZE; i && len; i--, len--) {
+                const uint8_t c1 = *s1++;
+                const uint8_t c2 = *s2++;
+                if (c1 != c2 || !c1) return (int)c1 - (int)c2;
+            }
+        }
+    }
+    return 0;
+}
+#else
+// Compare up to `len` characters a word at a time if strings are equally
+// aligned. Aligned loads never cross a page, so they can't fault reading past
+// the terminating null character.
+static int strncmp_kernel(const uint8_t *s1, const uint8_t *s2, size_t len) {
+    if (((uintptr_t)s1 & SWAR_MASK) == ((uintptr_t)s2 & SWAR_MASK)) {
+        for (; len && ((uintptr_t)s1 & SWAR_MASK); len--) {
+            const uint8_t c1 = *s1++;
+            const uint8_t c2 = *s2++;
+            if (c1 != c2 || !c1) return (int)c1 - (int)c2;
+        }
+        // Stop at the word with a mismatch or null character
+        for (; len >= sizeof(uintptr_t); len -= sizeof(uintptr_t)) {
+            const uintptr_t w1 = *(const uintptr_t *)(const void *)s1;
+            const uintptr_t w2 = *(const uintptr_t *)(const void *)s2;
+            if (w1 != w2 || swar_has_zero(w1)) break;
+            s1 += sizeof(uintptr_t);
+            s2 += sizeof(uintptr_t);
+        }
+    }
+    for (; len; len--) {
+        const uint8_t c1 = *s1++;
+        const uint8_t c2 = *s2++;
+        if (c1 != c2 || !c1) return (int)c1 - (int)c2;
+    }
+    return 0;
+}
+#endif
+
+int strcmp(const char *s1, const char *s2) {
+    if (__builtin_expect(!s1 || !s2, 0)) {
+        if (!s1) return (s2) ? -(int)(uint8_t)*s2 : 0;
+        return (int)(uint8_t)*s1;
+    }
+    return strncmp_kernel((const uint8_t *)s1, (const uint8_t *)s2, SIZE_MAX);
+}
+
+int strncmp(const char *s1, const char *s2, size_t len) {
+    if (!len) return 0;
+    if (__builtin_expect(!s1 || !s2, 0)) {
+        if (!s1) return (s2) ? -(int)(uint8_t)*s2 : 0;
+        return (int)(uint8_t)*s1;
+    }
+    return strncmp_kernel((const uint8_t *)s1, (const uint8_t *)s2, len);
 }
@@ -0,0 +1,131 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "noc_internal/common.h"
+#include "noc_internal/simd.h"
+
+// Character set is a 256-bit membership bitmap built once per call, so the
+// scan costs O(1) per character independent of the set size.
+typedef uint8_t charset_t[32];
+
+static inline bool charset_has(const charset_t set, uint8_t c) {
+    return (set[c >> 3] >> (c & 7)) & 1;
+}
+
+static void charset_build(charset_t set, const char *chars, bool with_null) {
+    memset(set, 0, sizeof(charset_t));
+    for (const uint8_t *c = (const uint8_t *)chars; *c; c++)
+        set[*c >> 3] |= (uint8_t)(1 << (*c & 7));
+    if (with_null) set[0] |= 1;
+}
+
+#if defined(NOC_SIMD_SHUFFLE)
+// Nibble classifier: each distinct high nibble of the set gets a bit, `hi`
+// maps the high nibble to its bit and `lo` maps the low nibble to bits of all
+// high nibbles it is combined with in the set. A byte is in the set if the
+// two lookups share a bit, so it works for up to 8 distinct high nibbles.
+static bool nibble_build(const charset_t set, uint8_t lo[16], uint8_t hi[16]) {
+    uint8_t bit = 1;
+
+    memset(lo, 0, 16);
+    for (size_t h = 0; h < 16; h++) {
+        const uint16_t row = (uint16_t)(set[2 * h] | (set[2 * h + 1] << 8));
+        hi[h] = 0;
+        if (!row) continue;
+        if (!bit) return false;
+        hi[h] = bit;
+        for (size_t l = 0; l < 16; l++)
+            if ((row >> l) & 1) lo[l] |= bit;
+        bit <<= 1;
+    }
+    return true;
+}
+
+// Length of the initial segment of `s` with bytes in (`accept`) or out of the
+// set. Null character must stop the scan in either case. Aligned loads never
+// cross a page, so can read past the terminator.
+static size_t nibble_span(const uint8_t *s, const uint8_t lo_tbl[16],
+                          const uint8_t hi_tbl[16], bool accept) {
+    const vec_t lo = vec_broadcast16(lo_tbl);
+    const vec_t hi = vec_broadcast16(hi_tbl);
+    const vec_t nibble = vec_set1(0x0f);
+    const vec_t zero = vec_zero();
+    // Comparison with zero marks bytes out of the set, invert it for reject
+    const vec_mask_t flip = accept ? 0 : VEC_MASK_ALL;
+
+    const uint8_t *a = vec_align_down(s);
+    vec_t v = vec_load(a);
+    vec_t r = vec_and(vec_shuffle(lo, vec_and(v, nibble)),
+                      vec_shuffle(hi, vec_and(vec_srli16(v, 4), nibble)));
+    // Skip bytes before the string
+    vec_mask_t m = (vec_eq_mask(r, zero) ^ flip) >> (s - a);
+    if (m) return stdc_trailing_zerosui(m);
+    do {
+        a += VEC_SIZE;
+        v = vec_load(a);
+        r = vec_and(vec_shuffle(lo, vec_and(v, nibble)),
+                    vec_shuffle(hi, vec_and(vec_srli16(v, 4), nibble)));
+        m = vec_eq_mask(r, zero) ^ flip;
+    } while (!m);
+    return (size_t)(a - s) + stdc_trailing_zerosui(m);
+}
+#endif
+
+#ifndef STRSPN_VECTOR_THRESHOLD
+// Segments shorter than this are scanned with the bitmap only, as building
+// the nibble classifier costs more than it saves for short tokens.
+#define STRSPN_VECTOR_THRESHOLD 16
+#endif
+
+static size_t span(const char *s, const charset_t set, bool accept) {
+    const uint8_t *p = (const uint8_t *)s;
+#if defined(NOC_SIMD_SHUFFLE)
+    for (size_t i = 0; i < STRSPN_VECTOR_THRESHOLD; i++, p++)
+        if (charset_has(set, *p) != accept) return i;
+    uint8_t lo[16], hi[16];
+    if (nibble_build(set, lo, hi))
+        return STRSPN_VECTOR_THRESHOLD + nibble_span(p, lo, hi, accept);
+#endif
+    while (charset_has(set, *p) == accept) p++;
+    return (size_t)(p - (const uint8_t *)s);
+}
+
+size_t strspn(const char *s, const char *characters) {
+    if (s == NULL || characters == NULL || !characters[0]) return 0;
+    // Single character doesn't need a set
+    if (!characters[1]) {
+        const char *p = s;
+        while (*p == characters[0]) p++;
+        return (size_t)(p - s);
+    }
+    charset_t set;
+    charset_build(set, characters, false);
+    return span(s, set, true);
+}
+
+size_t strcspn(const char *s, const char *characters) {
+    if (s == NULL) return 0;
+    if (characters == NULL || !characters[0]) return strlen(s);
+    if (!characters[1]) {
+        const char *p = strchr(s, characters[0]);
+        return p ? (size_t)(p - s) : strlen(s);
+    }
+    // Null character terminates the segment as any character of the set
+    charset_t set;
+    charset_build(set, characters, true);
+    return span(s, set, false);
+}
+
+char *strpbrk(const char *s1, const char *s2) {
+    if (s1 == NULL) return NULL;
+    s1 += strcspn(s1, s2);
+    return *s1 ? (char *)s1 : NULL;
+}
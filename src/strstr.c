@@ -0,0 +1,192 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "noc_internal/common.h"
+#include "noc_internal/simd.h"
+
+// Substring search using the Two-Way algorithm by Crochemore and Perrin. It
+// runs in linear time with constant extra space, so a hostile needle like
+// "aaa...ab" can't cause quadratic behavior as with naive search.
+
+// Compute the maximal suffix of `n` for the byte order, or the reversed order
+// if `rev` is set. Returns start of the suffix and stores its period.
+static size_t max_suffix(const uint8_t *n, size_t m, bool rev, size_t *period) {
+    size_t ms = 0;  // start of the maximal suffix found so far
+    size_t j = 1;   // start of the suffix compared against it
+    size_t k = 0;   // offset of compared bytes
+    size_t p = 1;   // period of the maximal suffix
+
+    while (j + k < m) {
+        const uint8_t a = n[j + k];
+        const uint8_t b = n[ms + k];
+        if (a == b) {
+            // Advance through repetition of the current period
+            if (++k == p) {
+                j += p;
+                k = 0;
+            }
+        } else if ((a < b) != rev) {
+            // Suffix at `j` is smaller, period grows to cover it
+            j += k + 1;
+            k = 0;
+            p = j - ms;
+        } else {
+            // Suffix at `j` is larger, restart from it
+            ms = j++;
+            k = 0;
+            p = 1;
+        }
+    }
+    *period = p;
+    return ms;
+}
+
+// Initial step of finding the length of strstr() haystack, short strings are
+// covered by one scan
+#define STRSTR_STEP 256
+
+// Haystack of memmem(), or of strstr() with length found lazily, so that an
+// early match doesn't cost strlen() of the whole string
+struct hay {
+    const uint8_t *h;
+    size_t len;   // Known length
+    size_t step;  // Next extension of `len`, 0 if it is the full length
+};
+
+// Extend known length of a string in doubling steps to at least `need` bytes.
+// Returns false if the string is shorter.
+static bool hay_extend(struct hay *s, size_t need) {
+    if (!s->step) return false;
+    const size_t step = MAX(need - s->len, s->step);
+    const uint8_t *z = memchr(s->h + s->len, 0, step);
+    if (z) {
+        s->len = (size_t)(z - s->h);
+        s->step = 0;
+    } else {
+        s->len += step;
+        s->step = 2 * step;
+    }
+    return need <= s->len;
+}
+
+// Check that haystack has at least `need` bytes.
+static inline __attribute__((always_inline)) bool hay_avail(struct hay *s,
+                                                            size_t need) {
+    return need <= s->len || hay_extend(s, need);
+}
+
+// Find `n` of length `m` > 0 in haystack starting from offset `j`.
+static const uint8_t *two_way(struct hay *s, size_t j, const uint8_t *n,
+                              size_t m) {
+    const uint8_t *h = s->h;
+    // Critical factorization is the later of two maximal suffixes
+    size_t p, p_rev;
+    size_t ms = max_suffix(n, m, false, &p);
+    const size_t ms_rev = max_suffix(n, m, true, &p_rev);
+    if (ms_rev > ms) {
+        ms = ms_rev;
+        p = p_rev;
+    }
+
+    if (memeq(n, n + p, ms)) {
+        // Needle is periodic. On a full match of the right half the shift is
+        // just the period, and the first `mem` bytes are known to match.
+        size_t mem = 0;
+        while (hay_avail(s, j + m)) {
+            size_t i = MAX(ms, mem);
+            while (i < m && n[i] == h[j + i]) i++;
+            if (i < m) {
+                j += i - ms + 1;
+                mem = 0;
+                continue;
+            }
+            i = ms;
+            while (i > mem && n[i - 1] == h[j + i - 1]) i--;
+            if (i <= mem) return h + j;
+            j += p;
+            mem = m - p;
+        }
+    } else {
+        // Halves are distinct, any mismatch in the left half allows the
+        // maximal shift.
+        p = MAX(ms, m - ms) + 1;
+        while (hay_avail(s, j + m)) {
+            size_t i = ms;
+            while (i < m && n[i] == h[j + i]) i++;
+            if (i < m) {
+                j += i - ms + 1;
+                continue;
+            }
+            i = ms;
+            while (i > 0 && n[i - 1] == h[j + i - 1]) i--;
+            if (i == 0) return h + j;
+            j += p;
+        }
+    }
+    return NULL;
+}
+
+#if defined(NOC_SIMD)
+// Compare first and last byte of the needle at VEC_SIZE haystack positions at
+// once and verify only the candidates. Verification is quadratic in the worst
+// case, so switch to two_way() once it did more work than the scan itself.
+static const uint8_t *search_vec(struct hay *s, const uint8_t *n, size_t m) {
+    const uint8_t *h = s->h;
+    const vec_t first = vec_set1(n[0]);
+    const vec_t last = vec_set1(n[m - 1]);
+    size_t work = 0;
+    size_t j = 0;
+
+    while (hay_avail(s, j + m - 1 + VEC_SIZE)) {
+        vec_mask_t c = vec_eq_mask(vec_loadu(h + j), first) &
+                       vec_eq_mask(vec_loadu(h + j + m - 1), last);
+        while (c) {
+            const size_t i = j + stdc_trailing_zerosui(c);
+            if (memeq(h + i + 1, n + 1, m - 2)) return h + i;
+            work += m;
+            c &= c - 1;
+        }
+        j += VEC_SIZE;
+        if (work > j + 256) break;
+    }
+    return two_way(s, j, n, m);
+}
+#endif
+
+// Find `n` of length `m` > 1 in the haystack.
+static const uint8_t *search(struct hay *s, const uint8_t *n, size_t m) {
+    if (!hay_avail(s, m)) return NULL;
+#if defined(NOC_SIMD)
+    return search_vec(s, n, m);
+#else
+    return two_way(s, 0, n, m);
+#endif
+}
+
+char *strstr(const char *s1, const char *s2) {
+    if (s1 == NULL || s2 == NULL) return NULL;
+    const size_t m = strlen(s2);
+    if (m == 0) return (char *)s1;
+
+    // Skip to the first candidate, often there is none at all
+    const char *h = strchr(s1, s2[0]);
+    if (h == NULL || m == 1) return (char *)h;
+    struct hay s = {.h = (const uint8_t *)h, .step = STRSTR_STEP};
+    return (char *)search(&s, (const uint8_t *)s2, m);
+}
+
+const void *memmem(const void *haystack, size_t hl, const void *needle,
+                   size_t nl) {
+    if (nl == 0) return haystack;
+    if (nl == 1) return memchr(haystack, *(const uint8_t *)needle, hl);
+    struct hay s = {.h = (const uint8_t *)haystack, .len = hl};
+    return search(&s, (const uint8_t *)needle, nl);
+}
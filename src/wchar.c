@@ -0,0 +1,31 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "noc_internal/common.h"
+
+STATIC_ASSERT(sizeof(wchar_t) == 2 || sizeof(wchar_t) == 4);
+
+wchar_t *wmemcpy(wchar_t *restrict dest, const wchar_t *restrict src,
+                 size_t n) {
+    return memcpy(dest, src, n * sizeof(wchar_t));
+}
+
+wchar_t *wmemmove(wchar_t *dest, const wchar_t *src, size_t n) {
+    return memmove(dest, src, n * sizeof(wchar_t));
+}
+
+wchar_t *wmemset(wchar_t *dest, wchar_t c, size_t n) {
+    if (sizeof(wchar_t) == 4)
+        memset32((uint32_t *)dest, (uint32_t)c, n);
+    else
+        memset16((uint16_t *)dest, (uint16_t)c, n);
+    return dest;
+}
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "noc_internal/common.h"
@@ -20,3 +21,67 @@ static bool test_atoi(void) {
     return is_test_succeed();
 }
 DECLARE_TEST(test_atoi);
+
+// Reference conversion, one digit at a time
+static void ref_u64toa(uint64_t v, bool negative, char *s) {
+    char tmp[UTOA_BUFFER_SIZE];
+    size_t n = 0;
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (negative) *s++ = '-';
+    while (n) *s++ = tmp[--n];
+    *s = 0;
+}
+
+static bool test_u64toa(void) {
+    char s[UTOA_BUFFER_SIZE], ref[UTOA_BUFFER_SIZE + 2];
+
+    TEST_PTR_EQ(u64toa(0, s), s + 1);
+    TEST_STR_EQ(s, "0");
+    TEST_PTR_EQ(u64toa(UINT64_MAX, s), s + 20);
+    TEST_STR_EQ(s, "18446744073709551615");
+    TEST_PTR_EQ(i64toa(INT64_MIN, s), s + 20);
+    TEST_STR_EQ(s, "-9223372036854775808");
+    i64toa(-1, s);
+    TEST_STR_EQ(s, "-1");
+
+    // Around every power of 10 and 2, against digit by digit conversion
+    for (uint64_t p = 1; p; p = (p <= UINT64_MAX / 10) ? p * 10 : 0)
+        for (uint64_t v = p - 2; v != p + 2; v++) {
+            u64toa(v, s);
+            ref_u64toa(v, false, ref);
+            TEST_STR_EQ(s, ref);
+        }
+    for (size_t i = 0; i < 64; i++) {
+        const uint64_t v = 1ULL << i;
+        u64toa(v - 1, s);
+        ref_u64toa(v - 1, false, ref);
+        TEST_STR_EQ(s, ref);
+        i64toa(-(int64_t)(v >> 1), s);
+        ref_u64toa(v >> 1, v > 1, ref);
+        TEST_STR_EQ(s, ref);
+    }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_u64toa);
+
+// Counters and timestamps, formatted the way logging does
+static bool bench_u64toa(void) {
+    char s[UTOA_BUFFER_SIZE];
+    uint64_t v = 1234567890123, acc = 0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++, v += 7919)
+        acc += (uint64_t)(u64toa(v, s) - s);
+    uint64_t conv = get_clock() - time;
+    time = get_clock();
+    for (size_t i = 0; i < 10000; i++, v += 7919)
+        acc += (uint64_t)snprintf(s, sizeof(s), "%lu", v);
+    time = get_clock() - time;
+    printf("13-digit values x 10000: u64toa %lu ns, snprintf %lu ns\n", conv,
+           time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_u64toa);
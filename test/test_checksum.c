@@ -0,0 +1,157 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <checksum.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+// Bit at a time references
+static uint32_t ref_crc(uint32_t poly, const uint8_t *p, size_t len) {
+    uint32_t c = ~0U;
+    for (size_t i = 0; i < len; i++) {
+        c ^= p[i];
+        for (size_t k = 0; k < 8; k++) c = (c >> 1) ^ (poly & -(c & 1));
+    }
+    return ~c;
+}
+
+static uint16_t ref_csum(const uint8_t *p, size_t len) {
+    uint32_t sum = 0;
+    uint16_t w;
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        memcpy(&w, p + i, 2);
+        sum += w;
+    }
+    if (len & 1) {
+        w = 0;
+        memcpy(&w, p + len - 1, 1);
+        sum += w;
+    }
+    while (sum >> 16) sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+static bool test_checksum_vectors(void) {
+    // RFC 1071 example, words are summed in native byte order
+    static const uint8_t rfc[] = {0x00, 0x01, 0xf2, 0x03,
+                                  0xf4, 0xf5, 0xf6, 0xf7};
+    uint8_t pkt[10];
+    uint16_t sum = csum_fold(csum_partial(rfc, sizeof(rfc), 0));
+
+    TEST_EQ(sum, ref_csum(rfc, sizeof(rfc)));
+    // Data with its checksum appended sums to zero
+    memcpy(pkt, rfc, sizeof(rfc));
+    memcpy(pkt + sizeof(rfc), &sum, 2);
+    TEST_EQ(csum_fold(csum_partial(pkt, sizeof(pkt), 0)), 0);
+
+    TEST_EQ(crc32(0, "123456789", 9), 0xcbf43926);
+    TEST_EQ(crc32c(0, "123456789", 9), 0xe3069283);
+    TEST_EQ(crc32(0, "", 0), 0);
+    TEST_EQ(crc32c(0, "", 0), 0);
+    // Chained
+    TEST_EQ(crc32(crc32(0, "12345", 5), "6789", 4), 0xcbf43926);
+    TEST_EQ(crc32c(crc32c(0, "1", 1), "23456789", 8), 0xe3069283);
+    return is_test_succeed();
+}
+DECLARE_TEST(test_checksum_vectors);
+
+static bool test_checksum_copy(void) {
+    static uint8_t src[600], dst[600];
+
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)rand();
+    // All-ones words to exercise carries
+    memset(src + 100, 0xff, 100);
+
+    for (size_t off = 0; off < 8; off++)
+        for (size_t len = 0; len < 500; len += (len < 40) ? 1 : 23) {
+            const uint8_t *s = src + off;
+            const uint16_t csum = ref_csum(s, len);
+            const uint32_t crc = ref_crc(0xedb88320, s, len);
+            const uint32_t crcc = ref_crc(0x82f63b78, s, len);
+
+            TEST_EQ(csum_fold(csum_partial(s, len, 0)), csum);
+            TEST_EQ(crc32(0, s, len), crc);
+            TEST_EQ(crc32c(0, s, len), crcc);
+
+            memset(dst, 0x5a, sizeof(dst));
+            TEST_EQ(csum_fold(memcpy_csum(dst + 1, s, len, 0)), csum);
+            TEST_MEMCMP(dst + 1, s, len);
+            TEST_EQ(dst[len + 1], 0x5a);
+            memset(dst, 0x5a, sizeof(dst));
+            TEST_EQ(memcpy_crc32(dst + 2, s, len, 0), crc);
+            TEST_MEMCMP(dst + 2, s, len);
+            TEST_EQ(dst[len + 2], 0x5a);
+            memset(dst, 0x5a, sizeof(dst));
+            TEST_EQ(memcpy_crc32c(dst + 3, s, len, 0), crcc);
+            TEST_MEMCMP(dst + 3, s, len);
+            TEST_EQ(dst[len + 3], 0x5a);
+
+            // Split at even length for checksum, any length for CRC
+            const size_t half = (len / 2) & ~(size_t)1;
+            TEST_EQ(csum_fold(csum_partial(s + half, len - half,
+                                           csum_partial(s, half, 0))),
+                    csum);
+            TEST_EQ(crc32(crc32(0, s, len / 2), s + len / 2, len - len / 2),
+                    crc);
+        }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_checksum_copy);
+
+// Receive path: copy a packet out of a ring and checksum it, fused against
+// memcpy() followed by a second pass.
+static bool bench_checksum(void) {
+    static uint8_t ring[1500 * 8], pkt[1500];
+    uint32_t acc = 0;
+
+    for (size_t i = 0; i < sizeof(ring); i++) ring[i] = (uint8_t)i;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 1000; i++)
+        acc += memcpy_csum(pkt, ring + (i & 7) * 1500, 1500, 0);
+    uint64_t fused = get_clock() - time;
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        memcpy(pkt, ring + (i & 7) * 1500, 1500);
+        acc += csum_partial(pkt, 1500, 0);
+    }
+    time = get_clock() - time;
+    printf("1500 bytes x 1000, csum:   fused %7lu ns, separate %7lu ns\n",
+           fused, time);
+
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++)
+        acc += memcpy_crc32(pkt, ring + (i & 7) * 1500, 1500, 0);
+    fused = get_clock() - time;
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        memcpy(pkt, ring + (i & 7) * 1500, 1500);
+        acc += crc32(0, pkt, 1500);
+    }
+    time = get_clock() - time;
+    printf("1500 bytes x 1000, crc32:  fused %7lu ns, separate %7lu ns\n",
+           fused, time);
+
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++)
+        acc += memcpy_crc32c(pkt, ring + (i & 7) * 1500, 1500, 0);
+    fused = get_clock() - time;
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        memcpy(pkt, ring + (i & 7) * 1500, 1500);
+        acc += crc32c(0, pkt, 1500);
+    }
+    time = get_clock() - time;
+    printf("1500 bytes x 1000, crc32c: fused %7lu ns, separate %7lu ns\n",
+           fused, time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_checksum);
@@ -216,3 +216,12 @@ struct test_case {
             .name = __testcase_##NAME,                             \
             .handler = NAME,                                       \
     }
+
+// Log line of benchmarks, mostly literal text with padded fields. snprintf()
+// time for it is measured by bench_snprintf.
+#define LOG_LINE_FORMAT                                                     \
+    "[%8u] sensor %-12s reading out of range, value %5d exceeds configured " \
+    "limit, check calibration\n"
+
+// Arguments of LOG_LINE_FORMAT for iteration `i`
+#define LOG_LINE_ARGS(i) (uint32_t)(i), "thermal0", (int)(i) - 5000
@@ -0,0 +1,113 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <dlog.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+static uint32_t records[1024];
+
+// Drop pending records
+static void dlog_reset(void) {
+    while (dlog_read(records, sizeof(records))) continue;
+    dlog_dropped();
+}
+
+static bool test_dlog(void) {
+    char name[8] = "pump", s[128];
+    struct dlog_record rec;
+
+    dlog_reset();
+    TEST_INT_EQ(dlog("%s: %d %u %lx %.2f %c %5.2s|%*d %%", name, -5, 7u,
+                     (uint64_t)0x1234567890, 3.14159, 'q', "xyz", 4, 9),
+                0);
+    // Strings are copied into the record
+    name[0] = 'X';
+    static const char *volatile hexdump = "%.4H";
+    TEST_INT_EQ(dlog(hexdump, "\x01\x02\xab\xff"), 0);
+    TEST_INT_EQ(dlog("no arguments"), 0);
+    TEST_INT_EQ(dlog("%s", "0123456789012345678901234567890123456789"), 0);
+
+    static const char *const expect[] = {
+        "pump: -5 7 1234567890 3.14 q    xy|   9 %", "0102abff",
+        "no arguments", "01234567890123456789012345678901"};
+    size_t len = dlog_read(records, sizeof(records));
+    const uint8_t *p = (const uint8_t *)records;
+    for (size_t i = 0; i < 4; i++) {
+        const size_t size = dlog_next(p, len, &rec);
+        TEST_NEQ(size, 0);
+        TEST_EQ(size % 4, 0);
+        const char *format = (const char *)(uintptr_t)rec.format;
+        TEST_INT_EQ(dlog_snprintf(s, sizeof(s), format, &rec),
+                    (int)strlen(expect[i]));
+        TEST_STR_EQ(s, expect[i]);
+        p += size;
+        len -= size;
+    }
+    TEST_EQ(len, 0);
+    TEST_EQ(dlog_next(p, len, &rec), 0);
+    TEST_EQ(dlog_read(records, sizeof(records)), 0);
+
+    // Missing arguments of a damaged record are zeroes
+    TEST_INT_EQ(dlog("%d %d", 1, 2), 0);
+    len = dlog_read(records, sizeof(records));
+    TEST_EQ(dlog_next(records, len, &rec), len);
+    rec.args_len -= 4;
+    dlog_snprintf(s, sizeof(s), "%d %d", &rec);
+    TEST_STR_EQ(s, "1 0");
+
+    // Unsupported format is not recorded
+    static const char *volatile bad = "%q";
+    TEST_INT_EQ(dlog(bad, 1), EOF);
+    TEST_EQ(dlog_dropped(), 1);
+    TEST_EQ(dlog_read(records, sizeof(records)), 0);
+
+    // Full buffer drops new records, reads return whole records only
+    const size_t rec_size = 2 * sizeof(uint32_t) + sizeof(uintptr_t);
+    size_t logged = 0;
+    while (dlog("%d", (int)logged) == 0) logged++;
+    TEST_EQ((logged + 1) * rec_size > DLOG_BUFFER_SIZE, true);
+    TEST_EQ(dlog("%d", 0), EOF);
+    TEST_EQ(dlog_dropped(), 2);
+    TEST_EQ(dlog_read(records, 2 * rec_size - 1), rec_size);
+    TEST_EQ(dlog_next(records, rec_size, &rec), rec_size);
+    dlog_snprintf(s, sizeof(s), "%d", &rec);
+    TEST_STR_EQ(s, "0");
+    TEST_EQ(dlog_read(records, 2 * rec_size), 2 * rec_size);
+
+    // Rest is read wrapped around the end of the ring
+    len = 0;
+    for (size_t n; (n = dlog_read(records, sizeof(records))) > 0;) len += n;
+    TEST_EQ(len, (logged - 3) * rec_size);
+
+    TEST_INT_EQ(dlog("flushed %s\n", "record"), 0);
+    TEST_INT_EQ(dlog_flush(), 15);
+    TEST_EQ(dlog_read(records, sizeof(records)), 0);
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_dlog);
+
+static bool bench_dlog(void) {
+    size_t acc = 0;
+
+    dlog_reset();
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++) {
+        if (dlog(LOG_LINE_FORMAT, LOG_LINE_ARGS(i)) < 0)
+            acc += dlog_read(records, sizeof(records));
+    }
+    time = get_clock() - time;
+    acc += dlog_read(records, sizeof(records));
+    dlog_reset();
+    printf("dlog log line x 10000: %lu ns\n", time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_dlog);
@@ -0,0 +1,175 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <encoding.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+static const char b64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Bit at a time reference
+static size_t ref_base64(char *d, const uint8_t *s, size_t len) {
+    size_t n = 0;
+    for (size_t bit = 0; bit < len * 8; bit += 6) {
+        uint32_t v = 0;
+        for (size_t i = bit; i < bit + 6; i++) {
+            v <<= 1;
+            if (i < len * 8) v |= (s[i / 8] >> (7 - i % 8)) & 1;
+        }
+        d[n++] = b64[v];
+    }
+    while (n % 4) d[n++] = '=';
+    return n;
+}
+
+static bool is_hex(int c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+           (c >= 'A' && c <= 'F');
+}
+
+static bool test_encoding_vectors(void) {
+    static const char *const b64_vec[][2] = {
+        {"", ""},         {"f", "Zg=="},         {"fo", "Zm8="},
+        {"foo", "Zm9v"},  {"foob", "Zm9vYg=="},  {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"}};
+    char s[64];
+    uint8_t b[64];
+
+    for (size_t i = 0; i < sizeof(b64_vec) / sizeof(b64_vec[0]); i++) {
+        const size_t len = strlen(b64_vec[i][0]);
+        const size_t elen = strlen(b64_vec[i][1]);
+        TEST_EQ(base64_encode(s, b64_vec[i][0], len), elen);
+        TEST_EQ(BASE64_ENCODED_LEN(len), elen);
+        TEST_MEMCMP(s, b64_vec[i][1], elen);
+        TEST_INT_EQ(base64_decode(b, b64_vec[i][1], elen), len);
+        TEST_MEMCMP(b, b64_vec[i][0], len);
+    }
+    // Padding is optional
+    TEST_INT_EQ(base64_decode(b, "Zm9vYg", 6), 4);
+    TEST_INT_EQ(base64_decode(b, "Zm9vYmE", 7), 5);
+    TEST_MEMCMP(b, "fooba", 5);
+    TEST_INT_EQ(base64_decode(b, "Zm9vY", 5), -1);
+    TEST_INT_EQ(base64_decode(b, "Zm=v", 4), -1);
+    TEST_INT_EQ(base64_decode(b, "Zm9v====", 8), -1);
+
+    TEST_EQ(hex_encode(s, "\x01\xab\xff\x7f", 4), 8);
+    TEST_MEMCMP(s, "01abff7f", 8);
+    TEST_INT_EQ(hex_decode(b, "01aBFf7F", 8), 4);
+    TEST_MEMCMP(b, "\x01\xab\xff\x7f", 4);
+    TEST_INT_EQ(hex_decode(b, "01a", 3), -1);
+    TEST_INT_EQ(hex_decode(b, "0g", 2), -1);
+    return is_test_succeed();
+}
+DECLARE_TEST(test_encoding_vectors);
+
+static bool test_encoding_roundtrip(void) {
+    static uint8_t src[200], dec[200 + 16];
+    static char enc[400 + 16], ref[400];
+
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)rand();
+
+    for (size_t len = 0; len < 150; len++) {
+        const uint8_t *s = src + len % 7;
+
+        TEST_EQ(hex_encode(enc, s, len), 2 * len);
+        for (size_t i = 0; i < len; i++) {
+            TEST_EQ(enc[2 * i], "0123456789abcdef"[s[i] >> 4]);
+            TEST_EQ(enc[2 * i + 1], "0123456789abcdef"[s[i] & 0xf]);
+        }
+        memset(dec, 0x5a, sizeof(dec));
+        TEST_INT_EQ(hex_decode(dec, enc, 2 * len), len);
+        TEST_MEMCMP(dec, s, len);
+        TEST_EQ(dec[len], 0x5a);
+
+        const size_t elen = ref_base64(ref, s, len);
+        TEST_EQ(base64_encode(enc, s, len), elen);
+        TEST_MEMCMP(enc, ref, elen);
+        memset(dec, 0x5a, sizeof(dec));
+        TEST_INT_EQ(base64_decode(dec, enc, elen), len);
+        TEST_MEMCMP(dec, s, len);
+        TEST_EQ(dec[len], 0x5a);
+    }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_encoding_roundtrip);
+
+// Every character value at every position, in vector and scalar parts
+static bool test_encoding_invalid(void) {
+    static uint8_t src[30], dec[64];
+    static char hex[60], enc[40];
+
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 37);
+    hex_encode(hex, src, sizeof(src));
+    base64_encode(enc, src, sizeof(src));
+
+    for (size_t pos = 0; pos < sizeof(hex); pos++)
+        for (int c = 0; c < 256; c++) {
+            const char old = hex[pos];
+            hex[pos] = (char)c;
+            TEST_INT_EQ(hex_decode(dec, hex, sizeof(hex)),
+                        is_hex(c) ? (intptr_t)sizeof(src) : -1);
+            hex[pos] = old;
+        }
+    for (size_t pos = 0; pos < sizeof(enc); pos++)
+        for (int c = 0; c < 256; c++) {
+            const char old = enc[pos];
+            enc[pos] = (char)c;
+            intptr_t expect = (c && strchr(b64, c)) ? (intptr_t)sizeof(src) : -1;
+            // Padding of the last group
+            if (c == '=' && pos == sizeof(enc) - 1) expect = sizeof(src) - 1;
+            TEST_INT_EQ(base64_decode(dec, enc, sizeof(enc)), expect);
+            enc[pos] = old;
+        }
+    TEST_INT_EQ(base64_decode(dec, enc, sizeof(enc)), sizeof(src));
+    TEST_MEMCMP(dec, src, sizeof(src));
+    return is_test_succeed();
+}
+DECLARE_TEST(test_encoding_invalid);
+
+static bool bench_encoding(void) {
+    static uint8_t src[4096], dec[4096 + 16];
+    static char enc[8192];
+    intptr_t acc = 0;
+
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)rand();
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 100; i++)
+        acc += (intptr_t)hex_encode(enc, src, 4096);
+    uint64_t enc_time = get_clock() - time;
+    time = get_clock();
+    for (size_t i = 0; i < 100; i++) acc += hex_decode(dec, enc, 8192);
+    time = get_clock() - time;
+    printf("hex 4096 bytes x 100: encode %lu ns, decode %lu ns\n", enc_time,
+           time);
+
+    time = get_clock();
+    for (size_t i = 0; i < 100; i++)
+        acc += (intptr_t)base64_encode(enc, src, 4095);
+    enc_time = get_clock() - time;
+    time = get_clock();
+    for (size_t i = 0; i < 100; i++)
+        acc += base64_decode(dec, enc, BASE64_ENCODED_LEN(4095));
+    time = get_clock() - time;
+    printf("base64 4095 bytes x 100: encode %lu ns, decode %lu ns\n",
+           enc_time, time);
+
+    time = get_clock();
+    // Extension is unknown to the compiler format checks
+    static const char *volatile hexdump = "%.128H";
+    for (size_t i = 0; i < 3200; i++)
+        acc += snprintf(enc, sizeof(enc), hexdump, src + i);
+    time = get_clock() - time;
+    printf("snprintf %%H 128 bytes x 3200: %lu ns\n", time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_encoding);
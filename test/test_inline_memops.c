@@ -0,0 +1,101 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+// Must be defined before <string.h> is included
+#define NOC_INLINE_MEMOPS 1
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+struct header {
+    uint16_t type;
+    uint16_t flags;
+    uint32_t len;
+    uint64_t id;
+};
+
+static bool test_inline_memops(void) {
+    static uint8_t buf[128];
+    struct header h = {.type = 1, .flags = 2, .len = 3, .id = 4}, g;
+    uint8_t src[16];
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t u64;
+
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(0xa0 + i);
+
+    // Constant sizes, expanded inline
+    memset(buf, 0x5a, sizeof(buf));
+    memcpy(buf + 1, &h, sizeof(h));
+    memcpy(&g, buf + 1, sizeof(g));
+    TEST_MEMCMP(&g, &h, sizeof(h));
+    TEST_EQ(buf[0], 0x5a);
+    TEST_EQ(buf[sizeof(h) + 1], 0x5a);
+    memcpy(&u16, src + 1, sizeof(u16));
+    memcpy(&u32, src + 3, sizeof(u32));
+    memcpy(&u64, src + 5, sizeof(u64));
+    TEST_MEMCMP(&u16, src + 1, 2);
+    TEST_MEMCMP(&u32, src + 3, 4);
+    TEST_MEMCMP(&u64, src + 5, 8);
+    memset(buf, 0x5a, 16);
+    memset(buf + 3, 0, 7);
+    TEST_MEMCHK(buf + 3, 0, 7);
+    TEST_EQ(buf[2], 0x5a);
+    TEST_EQ(buf[10], 0x5a);
+    TEST_PTR_EQ(memcpy(buf, src, 0), buf);
+
+    // Variable and large sizes, passed to the library
+    for (size_t len = 0; len < sizeof(src); len++) {
+        memset(buf, 0x5a, sizeof(buf));
+        TEST_PTR_EQ(memcpy(buf + len, src, len), buf + len);
+        TEST_MEMCMP(buf + len, src, len);
+        TEST_EQ(buf[2 * len], 0x5a);
+        TEST_PTR_EQ(memset(buf + len, 0, len), buf + len);
+        TEST_MEMCHK(buf + len, 0, len);
+    }
+    memset(buf, 0x33, sizeof(buf));
+    TEST_MEMCHK(buf, 0x33, sizeof(buf));
+    return is_test_succeed();
+}
+DECLARE_TEST(test_inline_memops);
+
+// Marshal a header field by field, inline against the library routine.
+static bool bench_inline_memops(void) {
+    static uint8_t pkt[sizeof(struct header) * 64];
+    struct header h = {.type = 1, .flags = 2, .len = 3, .id = 4};
+    uint32_t sum = 0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        uint8_t *p = pkt + (i & 63) * sizeof(h);
+        memcpy(p, &h.type, 2);
+        memcpy(p + 2, &h.flags, 2);
+        memcpy(p + 4, &h.len, 4);
+        memcpy(p + 8, &h.id, 8);
+        h.id++;
+    }
+    uint64_t time_inline = get_clock() - time;
+
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        uint8_t *p = pkt + (i & 63) * sizeof(h);
+        (memcpy)(p, &h.type, 2);
+        (memcpy)(p + 2, &h.flags, 2);
+        (memcpy)(p + 4, &h.len, 4);
+        (memcpy)(p + 8, &h.id, 8);
+        h.id++;
+    }
+    time = get_clock() - time;
+    printf("marshalling: inline %lu ns, library %lu ns\n", time_inline, time);
+
+    for (size_t i = 0; i < sizeof(pkt); i++) sum += pkt[i];
+    return sum != 0;
+}
+DECLARE_BENCH(bench_inline_memops);
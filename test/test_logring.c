@@ -0,0 +1,86 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <logring.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+static char text[LOGRING_SIZE];
+
+// Drop pending records
+static void logring_reset(void) {
+    while (logring_read(text, sizeof(text))) continue;
+    logring_dropped();
+}
+
+static bool test_logring(void) {
+    uint32_t ticket;
+
+    logring_reset();
+    TEST_INT_EQ(logring_printf("a=%d\n", 5), 4);
+    TEST_EQ(logring_read(text, sizeof(text)), 4);
+    TEST_TRUE(memcmp(text, "a=5\n", 4) == 0);
+    TEST_EQ(logring_read(text, sizeof(text)), 0);
+
+    // Records are output in order of reservation
+    char *first = logring_reserve(10, &ticket);
+    TEST_TRUE(first != NULL);
+    memcpy(first, "first", 5);
+    TEST_INT_EQ(logring_printf("%s", "second"), 6);
+    TEST_EQ(logring_read(text, sizeof(text)), 0);
+    logring_commit(ticket, 5);
+    TEST_EQ(logring_read(text, sizeof(text)), 11);
+    TEST_TRUE(memcmp(text, "firstsecond", 11) == 0);
+
+    // Long messages are truncated
+    static char line[300];
+    memset(line, 'x', sizeof(line) - 1);
+    TEST_INT_EQ(logring_printf("%s", line), LOGRING_MAX_RECORD - 5);
+    TEST_EQ(logring_read(text, sizeof(text)), LOGRING_MAX_RECORD - 5);
+    TEST_TRUE(memcmp(text, line, LOGRING_MAX_RECORD - 5) == 0);
+
+    // Records wrap around the end of the ring, full ring drops records
+    size_t logged = 0, checked = 0;
+    for (size_t round = 0; round < 10; round++) {
+        while (logring_printf("%04u|", (uint32_t)logged) == 5) logged++;
+        TEST_EQ(logring_dropped(), 1);
+        const size_t n = logring_read(text, sizeof(text));
+        TEST_EQ(n % 5, 0);
+        for (size_t i = 0; i < n; i += 5, checked++)
+            TEST_INT_EQ(atoi(text + i), (int)checked);
+    }
+    TEST_EQ(checked, logged);
+    // Unused reserved space is returned, 12 bytes are used per record
+    TEST_TRUE(logged >= 9 * ((LOGRING_SIZE - LOGRING_MAX_RECORD) / 12));
+
+    TEST_INT_EQ(logring_printf("logring drained\n"), 16);
+    TEST_EQ(logring_drain(), 16);
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_logring);
+
+static bool bench_logring(void) {
+    size_t acc = 0;
+
+    logring_reset();
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++) {
+        if (logring_printf(LOG_LINE_FORMAT, LOG_LINE_ARGS(i)) < 0)
+            acc += logring_read(text, sizeof(text));
+    }
+    time = get_clock() - time;
+    acc += logring_read(text, sizeof(text));
+    logring_reset();
+    printf("logring_printf log line x 10000: %lu ns\n", time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_logring);
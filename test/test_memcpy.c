@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <wchar.h>
 
 #include "noc_internal/common.h"
 #include "test_common.h"
@@ -148,3 +149,206 @@ static bool memcpy_unaligned_test(void) {
     return is_test_succeed();
 }
 DECLARE_TEST(memcpy_unaligned_test);
+
+// Test overlapping moves in both directions, various sizes and distances.
+static bool memmove_overlap_test(void) {
+    uint8_t *buf = (uint8_t *)d_buf;
+
+    for (size_t shift = 1; shift < 80; shift += 3)
+        for (size_t len = shift + 1; len <= 700; len += 11) {
+            // dest > src, copy backward
+            fill_rand(buf, 0x12345678, len);
+            TEST_PTR_EQ(memmove(buf + shift, buf, len), buf + shift);
+            TEST_EQ(count_rand_equal(buf + shift, 0x12345678, len), len);
+            TEST_EQ(count_rand_equal(buf, 0x12345678, shift), shift);
+
+            // dest < src, copy forward
+            fill_rand(buf + shift, 0x23456789, len);
+            TEST_PTR_EQ(memmove(buf, buf + shift, len), buf);
+            TEST_EQ(count_rand_equal(buf, 0x23456789, len), len);
+        }
+
+    // Unaligned destination, nothing written past the end
+    for (size_t len = 1; len <= 300; len++) {
+        memset(buf + len + 3, 0x5a, 32);
+        fill_rand(buf + 3, 0x34567890, len);
+        TEST_PTR_EQ(memmove(buf + 5, buf + 3, len), buf + 5);
+        TEST_EQ(count_rand_equal(buf + 5, 0x34567890, len), len);
+        TEST_MEMCHK(buf + len + 5, 0x5a, 30);
+    }
+    return is_test_succeed();
+}
+DECLARE_TEST(memmove_overlap_test);
+
+// Compare forward and backward overlapping moves across sizes and overlaps.
+static bool bench_memmove(void) {
+    static const size_t sizes[] = {16, 64, 256, 1024, 2048};
+    static const size_t shifts[] = {1, 8, 33, 512};
+    uint8_t *buf = (uint8_t *)d_buf;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        for (size_t j = 0; j < sizeof(shifts) / sizeof(shifts[0]); j++) {
+            const size_t len = sizes[i], shift = shifts[j];
+            uint64_t fwd = get_clock();
+            for (size_t k = 0; k < 1000; k++)
+                memmove(buf, buf + shift, len);
+            fwd = get_clock() - fwd;
+            uint64_t bwd = get_clock();
+            for (size_t k = 0; k < 1000; k++)
+                memmove(buf + shift, buf, len);
+            bwd = get_clock() - bwd;
+            printf("memmove %4zu bytes, shift %3zu: forward %6lu ns, "
+                   "backward %6lu ns\n",
+                   len, shift, fwd, bwd);
+        }
+    return true;
+}
+DECLARE_BENCH(bench_memmove);
+
+// Check every element in [from, to) equals `v`, elements around untouched.
+#define CHECK_FILL(buf, from, to, v, guard)                               \
+    do {                                                                  \
+        for (size_t k = 0; k < sizeof(buf) / sizeof(buf[0]); k++)         \
+            if (buf[k] != ((k >= (from) && k < (to)) ? (v) : (guard)))    \
+                TEST_FAIL(#buf " fill mismatch");                         \
+    } while (0)
+
+static bool memset_wide_test(void) {
+    static uint16_t b16[160];
+    static uint32_t b32[100];
+    static uint64_t b64[60];
+
+    // Every start and length
+    for (size_t off = 0; off < 20; off++)
+        for (size_t n = 0; n < 130; n += (n < 40) ? 1 : 7) {
+            memset(b16, 0x5a, sizeof(b16));
+            TEST_PTR_EQ(memset16(b16 + off, 0xf81f, n), b16 + off);
+            CHECK_FILL(b16, off, off + n, 0xf81f, 0x5a5a);
+            if (n > 70) continue;
+            memset(b32, 0x5a, sizeof(b32));
+            TEST_PTR_EQ(memset32(b32 + off, 0xdeadbeef, n), b32 + off);
+            CHECK_FILL(b32, off, off + n, 0xdeadbeef, 0x5a5a5a5a);
+            if (n > 35) continue;
+            memset(b64, 0x5a, sizeof(b64));
+            TEST_PTR_EQ(memset64(b64 + off, 0x0123456789abcdefULL, n),
+                        b64 + off);
+            CHECK_FILL(b64, off, off + n, 0x0123456789abcdefULL,
+                       0x5a5a5a5a5a5a5a5aULL);
+        }
+    return is_test_succeed();
+}
+DECLARE_TEST(memset_wide_test);
+
+static bool wmem_test(void) {
+    static wchar_t w[64], v[64];
+
+    TEST_PTR_EQ(wmemset(w, L'x', 64), w);
+    TEST_EQ(w[0], L'x');
+    TEST_EQ(w[63], L'x');
+    TEST_PTR_EQ(wmemset(w + 3, L'\x263a', 10), w + 3);
+    CHECK_FILL(w, 3, 13, L'\x263a', L'x');
+    for (size_t i = 0; i < 64; i++) v[i] = (wchar_t)(0x400 + i);
+    TEST_PTR_EQ(wmemcpy(w, v, 64), w);
+    TEST_MEMCMP(w, v, sizeof(w));
+    // Overlap in both directions
+    TEST_PTR_EQ(wmemmove(w + 1, w, 63), w + 1);
+    TEST_MEMCMP(w + 1, v, 63 * sizeof(wchar_t));
+    TEST_PTR_EQ(wmemmove(w, w + 1, 63), w);
+    TEST_MEMCMP(w, v, 63 * sizeof(wchar_t));
+    return is_test_succeed();
+}
+DECLARE_TEST(wmem_test);
+
+// Fill a 320x240 RGB565 framebuffer, memset16() against a plain loop.
+static bool bench_memset16(void) {
+    static uint16_t fb[320 * 240];
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10; i++) memset16(fb, (uint16_t)i, 320 * 240);
+    uint64_t time_fill = get_clock() - time;
+
+    time = get_clock();
+    for (size_t i = 0; i < 10; i++) {
+        uint16_t *p = fb;
+        for (size_t k = 0; k < 320 * 240; k++) p[k] = (uint16_t)i;
+    }
+    time = get_clock() - time;
+    printf("framebuffer fill: memset16 %lu ns, loop %lu ns\n", time_fill,
+           time);
+    return fb[0] == 9;
+}
+DECLARE_BENCH(bench_memset16);
+
+static bool memcpy2d_test(void) {
+    static uint8_t src[64 * 40], dst[80 * 40], ref[80 * 40];
+
+    fill_rand(src, 0x1234, sizeof(src));
+    // Sub-rectangles of different widths, including contiguous rows
+    for (size_t width = 0; width <= 64; width += (width < 8) ? 1 : 7) {
+        const size_t height = 1 + width % 13;
+        memset(dst, 0x5a, sizeof(dst));
+        memset(ref, 0x5a, sizeof(ref));
+        for (size_t y = 0; y < height; y++)
+            memcpy(ref + 3 + y * 80, src + 1 + y * 64, width);
+        TEST_PTR_EQ(memcpy2d(dst + 3, 80, src + 1, 64, width, height),
+                    dst + 3);
+        TEST_MEMCMP(dst, ref, sizeof(ref));
+
+        memcpy2d(dst, width, src, width, width, height);
+        TEST_MEMCMP(dst, src, width * height);
+    }
+    return is_test_succeed();
+}
+DECLARE_TEST(memcpy2d_test);
+
+static bool memcpy_gather_test(void) {
+    static uint8_t src[600], dst[600], frag[4][200];
+    struct mem_iovec iov[] = {{frag[0], 3},
+                              {frag[1], 0},
+                              {frag[2], 150},
+                              {frag[3], 200}};
+
+    fill_rand(src, 0x4321, sizeof(src));
+    // Scatter splits source over fragments in order
+    TEST_EQ(memcpy_scatter(iov, 4, src, 353), 353);
+    TEST_MEMCMP(frag[0], src, 3);
+    TEST_MEMCMP(frag[2], src + 3, 150);
+    TEST_MEMCMP(frag[3], src + 153, 200);
+    // Source longer than fragments, or fragments longer than source
+    TEST_EQ(memcpy_scatter(iov, 4, src, 500), 353);
+    TEST_EQ(memcpy_scatter(iov, 4, src, 100), 100);
+    TEST_EQ(memcpy_scatter(iov, 0, src, 100), 0);
+
+    memcpy_scatter(iov, 4, src, 353);
+    memset(dst, 0x5a, sizeof(dst));
+    TEST_EQ(memcpy_gather(dst, sizeof(dst), iov, 4), 353);
+    TEST_MEMCMP(dst, src, 353);
+    TEST_MEMCHK(dst + 353, 0x5a, sizeof(dst) - 353);
+    // Destination capacity is respected
+    memset(dst, 0x5a, sizeof(dst));
+    TEST_EQ(memcpy_gather(dst, 100, iov, 4), 100);
+    TEST_MEMCMP(dst, src, 100);
+    TEST_MEMCHK(dst + 100, 0x5a, sizeof(dst) - 100);
+    return is_test_succeed();
+}
+DECLARE_TEST(memcpy_gather_test);
+
+// Copy a 64x48 RGB565 sprite out of a 320 pixels wide framebuffer.
+static bool bench_memcpy2d(void) {
+    static uint16_t fb[320 * 64], sprite[64 * 48];
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 100; i++)
+        memcpy2d(sprite, 64 * 2, fb + (i & 7), 320 * 2, 64 * 2, 48);
+    uint64_t time_2d = get_clock() - time;
+
+    time = get_clock();
+    for (size_t i = 0; i < 100; i++)
+        for (size_t y = 0; y < 48; y++)
+            memcpy(sprite + y * 64, fb + (i & 7) + y * 320, 64 * 2);
+    time = get_clock() - time;
+    printf("sprite copy: memcpy2d %lu ns, memcpy per row %lu ns\n", time_2d,
+           time);
+    return true;
+}
+DECLARE_BENCH(bench_memcpy2d);
@@ -0,0 +1,90 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <memcpy_async.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+static size_t completed, completed_len;
+static void *done_dest[8];
+
+static void on_done(void *dest, size_t len) {
+    if (completed < sizeof(done_dest) / sizeof(done_dest[0]))
+        done_dest[completed] = dest;
+    completed++;
+    completed_len += len;
+}
+
+static bool test_memcpy_async(void) {
+    static uint8_t src[20000], dst[4][20000];
+    memcpy_ticket_t t[4];
+
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 7);
+    memset(dst, 0, sizeof(dst));
+    completed = completed_len = 0;
+
+    // Software engine only copies while polled
+    memcpy_async_register(&memcpy_async_soft);
+    t[0] = memcpy_async(dst[0], src, sizeof(src), on_done);
+    t[1] = memcpy_async(dst[1] + 1, src + 3, 10000, NULL);
+    t[2] = memcpy_async(dst[2], src, 5000, on_done);
+    TEST_FALSE(memcpy_done(t[0]));
+    TEST_EQ(completed, 0);
+
+    memcpy_async_poll();
+    TEST_FALSE(memcpy_done(t[0]));
+    memcpy_wait(t[1]);
+    TEST_TRUE(memcpy_done(t[0]));
+    TEST_TRUE(memcpy_done(t[1]));
+    TEST_MEMCMP(dst[0], src, sizeof(src));
+    TEST_MEMCMP(dst[1] + 1, src + 3, 10000);
+    TEST_EQ(dst[1][0], 0);
+    TEST_EQ(dst[1][10001], 0);
+    TEST_EQ(completed, 1);
+    TEST_PTR_EQ(done_dest[0], dst[0]);
+
+    // Short copy is queued after pending ones, so it can't be overwritten
+    t[3] = memcpy_async(dst[2] + 4000, src + 1, 100, on_done);
+    TEST_EQ(completed, 1);
+    TEST_FALSE(memcpy_done(t[3]));
+    memcpy_wait(t[3]);
+    TEST_TRUE(memcpy_done(t[2]));
+    TEST_MEMCMP(dst[2], src, 4000);
+    TEST_MEMCMP(dst[2] + 4000, src + 1, 100);
+    TEST_MEMCMP(dst[2] + 4100, src + 4100, 900);
+    TEST_EQ(completed, 3);
+    TEST_PTR_EQ(done_dest[1], dst[2]);
+    TEST_PTR_EQ(done_dest[2], dst[2] + 4000);
+    TEST_EQ(completed_len, sizeof(src) + 5000 + 100);
+
+    // Short copy is synchronous when nothing is queued
+    t[3] = memcpy_async(dst[3], src, 100, on_done);
+    TEST_EQ(completed, 4);
+    TEST_TRUE(memcpy_done(t[3]));
+    TEST_MEMCMP(dst[3], src, 100);
+
+    // More copies than queue slots
+    memset(dst, 0, sizeof(dst));
+    for (size_t i = 0; i < 2 * MEMCPY_ASYNC_QUEUE; i++)
+        t[0] = memcpy_async(dst[0] + i * 500, src + i, 500, NULL);
+    memcpy_wait(t[0]);
+    for (size_t i = 0; i < 2 * MEMCPY_ASYNC_QUEUE; i++)
+        TEST_MEMCMP(dst[0] + i * 500, src + i, 500);
+
+    // Without engine copies are synchronous
+    memcpy_async_register(NULL);
+    completed = 0;
+    t[0] = memcpy_async(dst[1], src, sizeof(src), on_done);
+    TEST_TRUE(memcpy_done(t[0]));
+    TEST_EQ(completed, 1);
+    TEST_MEMCMP(dst[1], src, sizeof(src));
+    return is_test_succeed();
+}
+DECLARE_TEST(test_memcpy_async);
@@ -0,0 +1,97 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <print.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+// Device which discards output
+static intptr_t null_write(void *cookie, const char *buf, size_t len) {
+    (void)cookie;
+    (void)buf;
+    return (intptr_t)len;
+}
+
+static const struct file_ops null_ops = {.write = null_write};
+
+// Output is kept in the buffer of fully buffered stream, and checked
+#define TEST_PRINT(result, ...)                                   \
+    f.len = 0;                                                    \
+    TEST_INT_EQ(noc_fprint(&f, __VA_ARGS__), sizeof(result) - 1); \
+    buf[f.len] = 0;                                               \
+    TEST_STR_EQ(buf, result);
+
+static bool test_print(void) {
+    char buf[256];
+    FILE f = FILE_INIT(&null_ops, NULL, buf, sizeof(buf) - 1, _IOFBF);
+
+    TEST_PRINT("a=5 b=-7 c=x d=1.5 e=10", "a=", 5, " b=", -7L, " c=",
+               (char)'x', " d=", 1.5, " e=", 10u);
+    TEST_PRINT("-9223372036854775808 18446744073709551615",
+               (int64_t)INT64_MIN, " ", (uint64_t)UINT64_MAX);
+    TEST_PRINT("-5 200 1 -2147483648", (int8_t)-5, " ", (uint8_t)200, " ",
+               true, " ", (int32_t)INT32_MIN);
+    TEST_PRINT("0.1 1e+100 -0 inf", 0.1, " ", 1e100, " ", -0.0, " ",
+               __builtin_inf());
+    // Shortest round-trip digits unless precision is set
+    TEST_PRINT("0.30000000000000004 1234567 0.3", 0.1 + 0.2, " ", 1234567.0,
+               " ", noc_prec(0.1 + 0.2, 6));
+
+    const char *null_str = NULL;
+    char text[] = "text";
+    TEST_PRINT("[null] text 0x1234", null_str, " ", text, " ",
+               (void *)0x1234);
+
+    // Options
+    TEST_PRINT("ff ffffffff ffffffffffffffff 41", noc_hex(255), " ",
+               noc_hex(-1), " ", noc_hex((int64_t)-1), " ",
+               noc_hex((char)'A'));
+    TEST_PRINT("0000beef|   42|ab  |-0007|-42   |  -42",
+               noc_zpad(noc_hex(0xbeefu), 8),
+               "|", noc_pad(42, 5), "|", noc_pad("ab", -4), "|",
+               noc_zpad(-7, 5), "|", noc_pad(-42, -6), "|", noc_pad(-42L, 5));
+    TEST_PRINT("abc 3.1 0x1.8p+0 007", noc_prec("abcdef", 3), " ",
+               noc_prec(3.14159, 2), " ", noc_hex(1.5), " ", noc_prec(7, 3));
+    // Character constants are int in C
+    TEST_PRINT("1234567890abc41100101", 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, (char)'a',
+               (char)'b', (char)'c', noc_hex((char)'A'), 'd', 'e');
+
+    // Precision out of range
+    TEST_PRINT("1<ERROR>\n", 1, noc_prec(5, 100), 2);
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_print);
+
+static bool bench_print(void) {
+    char buf[256];
+    FILE f = FILE_INIT(&null_ops, NULL, buf, sizeof(buf), _IOFBF);
+    int acc = 0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++)
+        acc += noc_fprint(&f, "[", noc_pad((uint32_t)i, 8), "] sensor ",
+                          noc_pad("thermal0", -12),
+                          " reading out of range, value ",
+                          noc_pad((int)i - 5000, 5),
+                          " exceeds configured limit, check calibration\n");
+    time = get_clock() - time;
+
+    uint64_t time_printf = get_clock();
+    for (size_t i = 0; i < 10000; i++)
+        acc += fprintf(&f, LOG_LINE_FORMAT, LOG_LINE_ARGS(i));
+    time_printf = get_clock() - time_printf;
+    printf("log line x 10000: noc_print %lu ns, fprintf %lu ns\n", time,
+           time_printf);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_print);
@@ -56,6 +56,14 @@ static bool test_snprintf(void) {
 
     TEST_SNPRINTF("0005", "%.4d", 5);
 
+    TEST_SNPRINTF("-0007|+0007|  -07", "%05d|%+05d|%5.2d", -7, 7, -7);
+    // 0 flag is ignored with precision
+    static const char *volatile zero_prec = "%05.2d|%05.2u|%05.3x|%05.1d";
+    TEST_SNPRINTF("  -07|   07|  0ff|    0", zero_prec, -7, 7, 255, 0);
+
+    TEST_SNPRINTF("-000000042|-7   | 0042|-5", "%010ld|%-5d|% 05d|%02hhd",
+                  (int64_t)-42, -7, 42, (char)-5);
+
     TEST_SNPRINTF("eeeedd0112345678", "%16lx", (uint64_t)0xeeeedd0112345678);
 
     TEST_SNPRINTF_TRUNC("12345678", 10, "%d", 1234567890);
@@ -74,6 +82,208 @@ static bool test_snprintf(void) {
 
     TEST_SNPRINTF("  Hel", "%5.3s", "Hello");
 
+    TEST_SNPRINTF("Hel  |", "%-5.3s|", "Hello");
+
+    TEST_SNPRINTF("[abc      ] [    -12]", "[%-9s] [%7d]", "abc", -12);
+
+    // Truncated in the middle of padding and literal text
+    TEST_SNPRINTF_TRUNC("ab   ", 12, "ab%8sxy", "z");
+
+    TEST_SNPRINTF_TRUNC("literal", 15, "literal text %d", 42);
+
+    // Hex dump extension, with format checks bypassed
+    static const char *volatile hexdump = "<%.5H>";
+    TEST_SNPRINTF("<0012ab80ff>", hexdump, "\x00\x12\xab\x80\xff");
+
+    // Sizing only
+    s[0] = 'x';
+    TEST_INT_EQ(snprintf(NULL, 0, "%d %s %5.2f", -100, "abc", 1.5), 14);
+    TEST_INT_EQ(snprintf(s, 0, "%d", 12345), 5);
+    TEST_EQ(s[0], 'x');
+
     return is_test_succeed();
 }
 DECLARE_TEST(test_snprintf);
+
+static bool test_snprintf_float(void) {
+    char s[400];
+
+    TEST_SNPRINTF("1.500000", "%f", 1.5);
+    TEST_SNPRINTF("1.250000", "%lf", 1.25);
+    TEST_SNPRINTF("10000000000000000000000", "%.0f", 1e22);
+    TEST_SNPRINTF("3.", "%#.0f", 3.0);
+    TEST_SNPRINTF("1.0", "%.1f", 0.96);
+    TEST_SNPRINTF("-0.001", "%.3f", -0.0005);
+
+    // Ties are resolved by the exact binary value, then to even
+    TEST_SNPRINTF("0.12", "%.2f", 0.125);
+    TEST_SNPRINTF("0.38", "%.2f", 0.375);
+    TEST_SNPRINTF("2.67", "%.2f", 2.675);
+    TEST_SNPRINTF("0", "%.0f", 0.5);
+    TEST_SNPRINTF("2", "%.0f", 1.5);
+    TEST_SNPRINTF("2", "%.0f", 2.5);
+    TEST_SNPRINTF("9.99e+00", "%.2e", 9.995);
+
+    TEST_SNPRINTF("1.234568e+04", "%e", 12345.678);
+    TEST_SNPRINTF("0.000e+00", "%.3e", 0.0);
+    TEST_SNPRINTF("1.000000E-300", "%E", 1e-300);
+    TEST_SNPRINTF("5e-324", "%.0e", 5e-324);
+
+    TEST_SNPRINTF("0.1", "%g", 0.1);
+    TEST_SNPRINTF("1e+22", "%g", 1e22);
+    TEST_SNPRINTF("100000", "%g", 100000.0);
+    TEST_SNPRINTF("1e+06", "%g", 1000000.0);
+    TEST_SNPRINTF("0.0001", "%g", 0.0001);
+    TEST_SNPRINTF("1e-05", "%g", 0.00001);
+    TEST_SNPRINTF("-0", "%g", -0.0);
+    TEST_SNPRINTF("1.23e+03", "%.3g", 1234.5);
+    TEST_SNPRINTF("1.00", "%#.3g", 1.0);
+    TEST_SNPRINTF("0.1", "%.10g", 0.1);
+    TEST_SNPRINTF("1.5E-10", "%G", 1.5e-10);
+    TEST_SNPRINTF("1.23457e+06", "%g", 1234567.0);
+    TEST_SNPRINTF("3.14159", "%g", 3.14159265358979);
+    TEST_SNPRINTF("10", "%g", 9.9999999);
+    TEST_SNPRINTF("0.3", "%g", 0.1 + 0.2);
+    TEST_SNPRINTF("0.30000000000000004", "%.17g", 0.1 + 0.2);
+    TEST_SNPRINTF("0.3333333333333333", "%.16g", 1.0 / 3);
+
+    // Digits past the shortest representation are exact
+    TEST_SNPRINTF("0.10000000000000000555", "%.20f", 0.1);
+    TEST_SNPRINTF("0.29999999999999999", "%.17f", 0.3);
+    TEST_SNPRINTF("99999999999999991611392", "%.0f", 1e23);
+    TEST_SNPRINTF("4.941e-324", "%.3e", 5e-324);
+    TEST_SNPRINTF(
+        "17976931348623157081452742373170435679807056752584499659891747680315"
+        "72607800285387605895586327668781715404589535143824642343213268894641"
+        "82768467546703537516986049910576551282076245490090389328944075868508"
+        "45513394230458323690322294816580855933212334827479782620414472316873"
+        "8177180919299881250404026184124858368.000000",
+        "%f", 1.7976931348623157e308);
+
+    TEST_SNPRINTF("[     3.142]", "[%10.3f]", 3.14159);
+    TEST_SNPRINTF("[3.142     ]", "[%-10.3f]", 3.14159);
+    TEST_SNPRINTF("[-00003.142]", "[%010.3f]", -3.14159);
+    TEST_SNPRINTF("+2.0", "%+.1f", 2.0);
+    TEST_SNPRINTF(" 2.0", "% .1f", 2.0);
+
+    TEST_SNPRINTF("0x1p+0", "%a", 1.0);
+    TEST_SNPRINTF("0x1.999999999999ap-4", "%a", 0.1);
+    TEST_SNPRINTF("0x1.ap-4", "%.1a", 0.1);
+    TEST_SNPRINTF("-0X1.4P+1", "%A", -2.5);
+    TEST_SNPRINTF("0x0p+0", "%a", 0.0);
+    TEST_SNPRINTF("0x0.0000000000001p-1022", "%a", 5e-324);
+    TEST_SNPRINTF("0x2p+0", "%.0a", 1.5);
+    TEST_SNPRINTF("0x1.p+0", "%#a", 1.0);
+
+    TEST_SNPRINTF("inf", "%f", __builtin_inf());
+    TEST_SNPRINTF("-INF", "%F", -__builtin_inf());
+    TEST_SNPRINTF("[  inf]", "[%05f]", __builtin_inf());
+    TEST_SNPRINTF("nan", "%e", __builtin_nan(""));
+    TEST_SNPRINTF("NAN", "%G", __builtin_nan(""));
+
+    TEST_SNPRINTF_TRUNC("1.2345", 8, "%f", 1.2345);
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_snprintf_float);
+
+static bool test_snprintf_compiled(void) {
+    char s[256], expect[256];
+    struct printf_compiled pc;
+
+    static const char log_fmt[] = "[%8u] %-6s %5d|%.3f|%%|%#x|%c";
+    TEST_INT_EQ(printf_compile(log_fmt, &pc), 0);
+    TEST_INT_EQ(snprintf_compiled(s, sizeof(s), &pc, 42, "ab", -7, 2.5,
+                                  0x1f, 'z'),
+                snprintf(expect, sizeof(expect), log_fmt, 42, "ab", -7, 2.5,
+                         0x1f, 'z'));
+    TEST_STR_EQ(s, expect);
+
+    // Width and precision from arguments, literal text only
+    TEST_INT_EQ(printf_compile("<%*d|%-*.*s>", &pc), 0);
+    TEST_INT_EQ(snprintf_compiled(s, sizeof(s), &pc, 4, 7, 6, 2, "xyz"), 13);
+    TEST_STR_EQ(s, "<   7|xy    >");
+    TEST_INT_EQ(printf_compile("plain text", &pc), 0);
+    TEST_INT_EQ(snprintf_compiled(s, sizeof(s), &pc), 10);
+    TEST_STR_EQ(s, "plain text");
+    TEST_INT_EQ(printf_compile("", &pc), 0);
+    TEST_INT_EQ(snprintf_compiled(s, sizeof(s), &pc), 0);
+    TEST_STR_EQ(s, "");
+
+    // Truncated output reports full length
+    TEST_INT_EQ(printf_compile("value %d", &pc), 0);
+    TEST_INT_EQ(snprintf_compiled(s, 8, &pc, 12345), 11);
+    TEST_STR_EQ(s, "value 1");
+    TEST_INT_EQ(snprintf_compiled(NULL, 0, &pc, 12345), 11);
+
+    // Invalid formats are rejected once
+    TEST_INT_EQ(printf_compile("%q", &pc), EOF);
+    TEST_INT_EQ(printf_compile("%5", &pc), EOF);
+    TEST_INT_EQ(printf_compile("%H", &pc), EOF);
+    TEST_INT_EQ(printf_compile("%1000d", &pc), EOF);
+    TEST_INT_EQ(printf_compile("%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d", &pc),
+                EOF);
+
+    // Width argument out of range
+    TEST_INT_EQ(printf_compile("a%*d", &pc), 0);
+    TEST_INT_EQ(snprintf_compiled(s, sizeof(s), &pc, 1000, 1), 9);
+    TEST_STR_EQ(s, "a<ERROR>\n");
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_snprintf_compiled);
+
+static bool bench_snprintf(void) {
+    char s[256];
+    int acc = 0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++)
+        acc += snprintf(s, sizeof(s), LOG_LINE_FORMAT, LOG_LINE_ARGS(i));
+    time = get_clock() - time;
+    printf("snprintf log line x 10000: %lu ns\n", time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_snprintf);
+
+static bool bench_snprintf_float(void) {
+    char s[64];
+    int acc = 0;
+    double v = 1.0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++, v *= 1.0001)
+        acc += snprintf(s, sizeof(s), "%g %.3f %e", v, v, 1.0 / v);
+    time = get_clock() - time;
+    printf("snprintf %%g %%.3f %%e x 10000: %lu ns\n", time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_snprintf_float);
+
+// Same log line with format parsed once
+static bool bench_snprintf_compiled(void) {
+    char s[256];
+    int acc = 0;
+    struct printf_compiled pc;
+
+    printf_compile(LOG_LINE_FORMAT, &pc);
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++)
+        acc += snprintf_compiled(s, sizeof(s), &pc, LOG_LINE_ARGS(i));
+    time = get_clock() - time;
+    printf("snprintf_compiled log line x 10000: %lu ns\n", time);
+
+    printf_compile("%s: %d %x\n", &pc);
+    uint64_t time_short = get_clock();
+    for (size_t i = 0; i < 10000; i++)
+        acc += snprintf(s, sizeof(s), "%s: %d %x\n", "id", (int)i, (int)i);
+    time_short = get_clock() - time_short;
+    time = get_clock();
+    for (size_t i = 0; i < 10000; i++)
+        acc += snprintf_compiled(s, sizeof(s), &pc, "id", (int)i, (int)i);
+    time = get_clock() - time;
+    printf("\"%%s: %%d %%x\" x 10000: snprintf %lu ns, compiled %lu ns\n",
+           time_short, time);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_snprintf_compiled);
@@ -0,0 +1,148 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+static bool test_stdio(void) {
+    char *const saved_buf = stdout->buf;
+    const size_t saved_size = stdout->size;
+    const int saved_mode = stdout->mode;
+    char buf[32];
+
+    // Fully buffered output stays in the buffer
+    TEST_INT_EQ(setvbuf(stdout, buf, _IOFBF, sizeof(buf)), 0);
+    TEST_INT_EQ(printf("a=%d", 5), 3);
+    TEST_INT_EQ(putchar('\n'), '\n');
+    TEST_INT_GE(fputs("bc", stdout), 0);
+    TEST_INT_GE(puts("d"), 0);
+    TEST_EQ(stdout->len, 8);
+    TEST_MEMCMP(buf, "a=5\nbcd\n", 8);
+    TEST_INT_EQ(putchar(0x141), 0x41);
+    TEST_EQ(stdout->len, 9);
+    TEST_INT_EQ(setvbuf(stdout, NULL, 3, 0), EOF);
+    // Discard test output
+    stdout->len = 0;
+
+    // Line buffered output is flushed at the end of a line
+    TEST_INT_EQ(setvbuf(stdout, NULL, _IOLBF, 0), 0);
+    TEST_PTR_EQ(stdout->buf, buf);
+    TEST_INT_EQ(printf("[line buffered"), 14);
+    TEST_EQ(stdout->len, 14);
+    TEST_INT_EQ(printf(" %s]\n", "stdout"), 9);
+    TEST_EQ(stdout->len, 0);
+
+    // Unbuffered output is flushed at the end of each call
+    TEST_INT_EQ(setvbuf(stdout, NULL, _IONBF, 0), 0);
+    TEST_INT_EQ(printf("[unbuffered "), 12);
+    TEST_EQ(stdout->len, 0);
+    TEST_INT_EQ(putchar(']'), ']');
+    TEST_EQ(stdout->len, 0);
+    TEST_INT_EQ(putchar('\n'), '\n');
+
+    // Output longer than the buffer
+    TEST_INT_EQ(setvbuf(stdout, NULL, _IOFBF, 0), 0);
+    TEST_INT_EQ(printf("[%-40s|%*s]", "fully buffered, longer than buffer", 40,
+                       "padding longer than buffer"),
+                83);
+    TEST_LT(stdout->len, sizeof(buf));
+    TEST_INT_EQ(fflush(stdout), 0);
+    TEST_EQ(stdout->len, 0);
+    TEST_INT_EQ(putchar('\n'), '\n');
+    TEST_EQ(stdout->len, 1);
+
+    TEST_INT_EQ(setvbuf(stdout, saved_buf, saved_mode, saved_size), 0);
+    TEST_PTR_EQ(stdout->buf, saved_buf);
+    return is_test_succeed();
+}
+DECLARE_TEST(test_stdio);
+
+// Memory device taking at most 5 bytes per write and 3 bytes per read
+struct memdev {
+    char data[128];
+    size_t len;
+    size_t pos;
+    size_t writes;
+};
+
+static intptr_t memdev_write(void *cookie, const char *buf, size_t len) {
+    struct memdev *dev = (struct memdev *)cookie;
+    len = MIN(len, MIN((size_t)5, sizeof(dev->data) - dev->len));
+    if (!len) return -1;
+    memcpy(dev->data + dev->len, buf, len);
+    dev->len += len;
+    dev->writes++;
+    return (intptr_t)len;
+}
+
+static intptr_t memdev_read(void *cookie, char *buf, size_t len) {
+    struct memdev *dev = (struct memdev *)cookie;
+    len = MIN(len, MIN((size_t)3, dev->len - dev->pos));
+    memcpy(buf, dev->data + dev->pos, len);
+    dev->pos += len;
+    return (intptr_t)len;
+}
+
+static const struct file_ops memdev_ops = {.write = memdev_write,
+                                           .read = memdev_read};
+
+static bool test_file(void) {
+    struct memdev dev = {0};
+    char buf[16], in[32];
+    FILE f = FILE_INIT(&memdev_ops, &dev, buf, sizeof(buf), _IOFBF);
+
+    TEST_INT_EQ(fprintf(&f, "x=%d;", 42), 5);
+    TEST_EQ(fwrite("abcdef", 2, 3, &f), 3);
+    TEST_EQ(dev.len, 0);
+
+    // Format in place
+    size_t avail;
+    char *p = fborrow(&f, UTOA_BUFFER_SIZE, &avail);
+    TEST_PTR_EQ(p, NULL);
+    TEST_EQ(dev.len, 0);
+    p = fborrow(&f, 4, &avail);
+    TEST_PTR_EQ(p, buf + 11);
+    TEST_EQ(avail, 5);
+    memcpy(p, "1234", 4);
+    TEST_INT_EQ(fcommit(&f, 4), 0);
+    p = fborrow(&f, 8, &avail);
+    TEST_PTR_EQ(p, buf);
+    TEST_EQ(avail, sizeof(buf));
+    TEST_EQ(dev.len, 15);
+    TEST_EQ(dev.writes, 3);
+    TEST_INT_EQ(fcommit(&f, (size_t)(u64toa(987654321, p) - p)), 0);
+    TEST_INT_EQ(fflush(&f), 0);
+    TEST_EQ(dev.len, 24);
+    TEST_MEMCMP(dev.data, "x=42;abcdef1234987654321", 24);
+
+    // Read in parts
+    TEST_EQ(fread(in, 4, 3, &f), 3);
+    TEST_MEMCMP(in, "x=42;abcdef1", 12);
+    TEST_EQ(fread(in, 5, 3, &f), 2);
+    TEST_MEMCMP(in, "234987654321", 12);
+    TEST_EQ(fread(in, 1, 1, &f), 0);
+
+    // No buffer, every call goes to the device
+    FILE raw = FILE_INIT(&memdev_ops, &dev, NULL, 0, _IONBF);
+    dev.len = 0;
+    TEST_INT_EQ(fprintf(&raw, "[%*s]", 20, "x"), 22);
+    TEST_INT_EQ(fputs("end", &raw), 0);
+    TEST_EQ(dev.len, 25);
+    TEST_MEMCMP(dev.data, "[                   x]end", 25);
+
+    // Write error is reported when the device is full
+    dev.len = sizeof(dev.data) - 2;
+    TEST_EQ(fwrite("abc", 1, 3, &raw), 0);
+    TEST_INT_EQ(fputs("abc", &raw), EOF);
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_file);
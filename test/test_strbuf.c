@@ -0,0 +1,106 @@
+// Copyright 2022 Vadim Sukhomlinov
+
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strbuf.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "noc_internal/common.h"
+#include "test_common.h"
+
+static bool test_strbuf(void) {
+    struct strbuf sb = STRBUF_INIT;
+
+    TEST_INT_EQ(strbuf_append(&sb, "key", 3), 0);
+    TEST_STR_EQ(sb.buf, "key");
+    TEST_EQ(sb.size, STRBUF_MIN_SIZE);
+    TEST_INT_EQ(strbuf_printf(&sb, "=%d;", 42), 4);
+    TEST_STR_EQ(sb.buf, "key=42;");
+    TEST_EQ(sb.len, 7);
+
+    // Geometric growth
+    for (size_t i = 0; i < 100; i++)
+        TEST_INT_EQ(strbuf_printf(&sb, "%-8u|", (uint32_t)i), 9);
+    TEST_EQ(sb.len, 907);
+    TEST_EQ(sb.size, 16 * STRBUF_MIN_SIZE);
+    TEST_STRN_EQ(sb.buf + 7 + 99 * 9, "99      |", 9);
+
+    // Invalid format leaves the string unchanged
+    static const char *volatile bad = "abc%z";
+    TEST_INT_EQ(strbuf_printf(&sb, bad, 1), EOF);
+    TEST_EQ(sb.len, 907);
+    TEST_EQ(sb.buf[907], 0);
+    static const char *volatile trailing = "abc%";
+    TEST_INT_EQ(strbuf_printf(&sb, trailing), EOF);
+    TEST_INT_EQ(strbuf_printf(&sb, "abc%200d", 1), EOF);
+    TEST_EQ(sb.len, 907);
+    TEST_EQ(sb.buf[907], 0);
+
+    // Write in place
+    char *p = strbuf_reserve(&sb, 2000);
+    TEST_PTR_NONNULL(p);
+    TEST_GE(sb.size, 2908);
+    memset(p, 'z', 2000);
+    strbuf_commit(&sb, 2000);
+    TEST_EQ(strlen(sb.buf), 2907);
+
+    strbuf_free(&sb);
+    TEST_PTR_NULL(sb.buf);
+    TEST_EQ(sb.size, 0);
+
+    char *str;
+    TEST_INT_EQ(asprintf(&str, "%s-%05d-%c", "id", 42, 'x'), 10);
+    TEST_STR_EQ(str, "id-00042-x");
+    free(str);
+    TEST_INT_EQ(asprintf(&str, "%s", ""), 0);
+    TEST_STR_EQ(str, "");
+    free(str);
+    char part[201];
+    memset(part, 'a', 200);
+    part[200] = 0;
+    TEST_INT_EQ(asprintf(&str, "%s|%100d", part, 1), 301);
+    TEST_EQ(strlen(str), 301);
+    TEST_EQ(str[200], '|');
+    TEST_EQ(str[300], '1');
+    free(str);
+    // Width over the limit is an error, not "<ERROR>" text
+    str = part;
+    TEST_INT_EQ(asprintf(&str, "%s%200d", part, 1), EOF);
+    TEST_PTR_EQ(str, NULL);
+
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strbuf);
+
+#define LOG_LINE LOG_LINE_FORMAT, LOG_LINE_ARGS(i)
+
+static bool bench_asprintf(void) {
+    size_t acc = 0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 10000; i++) {
+        char *str;
+        acc += (size_t)asprintf(&str, LOG_LINE);
+        free(str);
+    }
+    time = get_clock() - time;
+
+    // Size first, then format
+    uint64_t time_2pass = get_clock();
+    for (size_t i = 0; i < 10000; i++) {
+        const int len = snprintf(NULL, 0, LOG_LINE);
+        char *str = malloc((size_t)len + 1);
+        acc += (size_t)snprintf(str, (size_t)len + 1, LOG_LINE);
+        free(str);
+    }
+    time_2pass = get_clock() - time_2pass;
+    printf("log line x 10000: asprintf %lu ns, snprintf twice %lu ns\n", time,
+           time_2pass);
+    return acc != 0;
+}
+DECLARE_BENCH(bench_asprintf);
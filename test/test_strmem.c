@@ -17,18 +17,44 @@ static bool test_strlen(void) {
     TEST_EQ(strlen("1"), 1);
     TEST_EQ(strlen("12"), 2);
     TEST_EQ(strlen("abcdefghijklmnoprqstuvwxyz"), 26);
+
+    // Every start alignment and length, bytes above 0x7f
+    static char s[400];
+    memset(s, 0x80, sizeof(s));
+    for (size_t off = 0; off < 64; off++)
+        for (size_t len = 0; len < 300; len++) {
+            s[off + len] = 0;
+            TEST_EQ(strlen(s + off), len);
+            s[off + len] = (char)0xff;
+        }
     return is_test_succeed();
 }
 DECLARE_TEST(test_strlen);
 
 static bool bench_strlen(void) {
+    static char l[16384];
     char s[256];
+    size_t len = 0;
+
+    uint64_t time = get_clock();
     for (size_t i = 0; i < 256; i++) {
         s[i] = 0;
-        strlen(s);
+        len += strlen(s);
         s[i] = 32;
     }
-    return true;
+    time = get_clock() - time;
+    printf("strlen up to 256 bytes: %lu ns\n", time);
+
+    memset(l, 32, sizeof(l));
+    for (size_t size = 4096; size <= sizeof(l); size *= 2) {
+        l[size - 1] = 0;
+        time = get_clock();
+        for (size_t i = 0; i < 100; i++) len += strlen(l + (i & 15));
+        time = get_clock() - time;
+        printf("strlen %zu bytes x 100: %lu ns\n", size, time);
+        l[size - 1] = 32;
+    }
+    return len != 0;
 }
 DECLARE_BENCH(bench_strlen);
 
@@ -93,3 +119,553 @@ static bool test_memcmp(void) {
     return is_test_succeed();
 }
 DECLARE_TEST(test_memcmp);
+
+// Reference implementation of memcmp() for result sign.
+static int ref_memcmp(const uint8_t *a, const uint8_t *b, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        if (a[i] != b[i]) return (int)a[i] - (int)b[i];
+    return 0;
+}
+
+static int sign(int x) { return (x > 0) - (x < 0); }
+
+static bool test_memcmp_mismatch(void) {
+    static uint8_t a[300], b[300];
+
+    for (size_t i = 0; i < sizeof(a); i++) a[i] = b[i] = (uint8_t)(i * 7);
+
+    // Check every length, alignment and mismatch position with both signs.
+    for (size_t oa = 0; oa < 8; oa += 3)
+        for (size_t ob = 0; ob < 8; ob++)
+            for (size_t len = 1; len < 200; len += 7)
+                for (size_t pos = 0; pos < len; pos++) {
+                    b[ob + pos] = (uint8_t)(a[oa + pos] + 0x80);
+                    const int ref = ref_memcmp(a + oa, b + ob, len);
+                    TEST_INT_EQ(sign(memcmp(a + oa, b + ob, len)), sign(ref));
+                    TEST_INT_EQ(sign(memcmp(b + ob, a + oa, len)), -sign(ref));
+                    TEST_EQ(memeq(a + oa, b + ob, len), ref == 0);
+                    b[ob + pos] = a[oa + pos];
+                    TEST_INT_EQ(memcmp(a + oa, b + ob, len),
+                                ref_memcmp(a + oa, b + ob, len));
+                    TEST_EQ(memeq(a + oa, b + ob, len),
+                            ref_memcmp(a + oa, b + ob, len) == 0);
+                }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_memcmp_mismatch);
+
+static bool test_memeq(void) {
+    TEST_TRUE(memeq("", "", 0));
+    TEST_TRUE(memeq("a", "b", 0));
+    TEST_TRUE(memeq("azx", "azx", 4));
+    TEST_FALSE(memeq("azx345", "azx346", 6));
+    TEST_TRUE(memeq("azx345", "azx346", 5));
+    return is_test_succeed();
+}
+DECLARE_TEST(test_memeq);
+
+// Typical key sizes, and a firmware-chunk sized buffer.
+static bool bench_memcmp(void) {
+    static uint8_t a[4096], b[4096];
+    int res = 0;
+
+    for (size_t i = 0; i < sizeof(a); i++) a[i] = b[i] = (uint8_t)i;
+    for (size_t i = 0; i < 1000; i++) {
+        res += memcmp(a, b, 16);
+        res += memcmp(a + 1, b + 1, 40);
+        res += memcmp(a, b, sizeof(a));
+        res += !memeq(a, b, sizeof(a));
+    }
+    return res == 0;
+}
+DECLARE_BENCH(bench_memcmp);
+
+static bool test_memchr(void) {
+    static uint8_t buf[300];
+    const char *s = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+    TEST_PTR_EQ(memchr(s, 'a', 36), s);
+    TEST_PTR_EQ(memchr(s, '9', 36), s + 35);
+    TEST_PTR_NULL(memchr(s, '9', 35));
+    TEST_PTR_NULL(memchr(s, 'a', 0));
+    TEST_PTR_EQ(memchr(s, 0, 37), s + 36);
+    TEST_PTR_EQ(memrchr(s, 'a', 36), s);
+    TEST_PTR_NULL(memrchr(s + 1, 'a', 35));
+    TEST_PTR_NULL(memrchr(s, 'a', 0));
+    TEST_EQ(strnlen(s, 100), 36);
+    TEST_EQ(strnlen(s, 10), 10);
+
+    // Every start, length and match position, match value above 0x7f.
+    memset(buf, 0x11, sizeof(buf));
+    for (size_t off = 0; off < 40; off++)
+        for (size_t len = 0; len < 100; len++) {
+            const uint8_t *b = buf + off;
+            TEST_PTR_NULL(memchr(b, 0xf0, len));
+            TEST_PTR_NULL(memrchr(b, 0xf0, len));
+            // Matches just outside of the buffer are ignored
+            buf[off + len] = 0xf0;
+            if (off) buf[off - 1] = 0xf0;
+            TEST_PTR_NULL(memchr(b, 0xf0, len));
+            TEST_PTR_NULL(memrchr(b, 0xf0, len));
+            for (size_t pos = 0; pos < len; pos++) {
+                buf[off + pos] = 0xf0;
+                TEST_PTR_EQ(memchr(b, 0xf0, len), b + pos);
+                TEST_PTR_EQ(memrchr(b, 0xf0, len), b + pos);
+                TEST_PTR_EQ(memchr(b, 0xf0, pos + 1), b + pos);
+                TEST_PTR_EQ(memrchr(b, 0xf0, pos + 1), b + pos);
+                buf[off + pos] = 0x11;
+            }
+            buf[off + len] = 0x11;
+            if (off) buf[off - 1] = 0x11;
+        }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_memchr);
+
+// Delimiter search in a packet sized buffer.
+static bool bench_memchr(void) {
+    static char pkt[1500];
+    const void *res = NULL;
+
+    memset(pkt, 'x', sizeof(pkt));
+    pkt[0] = ',';
+    pkt[sizeof(pkt) - 2] = '\r';
+    pkt[sizeof(pkt) - 1] = '\n';
+    for (size_t i = 0; i < 1000; i++) {
+        res = memchr(pkt + (i & 7), '\n', sizeof(pkt) - (i & 7));
+        res = memrchr(pkt, ',', sizeof(pkt));
+    }
+    return res != NULL;
+}
+DECLARE_BENCH(bench_memchr);
+
+static bool test_strcmp_mismatch(void) {
+    static char a[160], b[160];
+
+    // Every alignment, length and mismatch position
+    for (size_t oa = 0; oa < 9; oa += 4)
+        for (size_t ob = 0; ob < 9; ob++)
+            for (size_t len = 0; len < 100; len += 3) {
+                char *sa = a + oa, *sb = b + ob;
+                for (size_t i = 0; i < len; i++)
+                    sa[i] = sb[i] = (char)('A' + (i % 50));
+                sa[len] = sb[len] = 0;
+                TEST_INT_EQ(strcmp(sa, sb), 0);
+                TEST_INT_EQ(strncmp(sa, sb, len + 5), 0);
+                for (size_t pos = 0; pos < len; pos++) {
+                    sb[pos] = (char)0xf0;
+                    TEST_INT_LT(strcmp(sa, sb), 0);
+                    TEST_INT_GT(strcmp(sb, sa), 0);
+                    TEST_INT_LT(strncmp(sa, sb, pos + 1), 0);
+                    TEST_INT_EQ(strncmp(sa, sb, pos), 0);
+                    sb[pos] = sa[pos];
+                }
+                // Prefix compares less
+                if (len) {
+                    sb[len - 1] = 0;
+                    TEST_INT_GT(strcmp(sa, sb), 0);
+                    TEST_INT_LT(strncmp(sb, sa, len), 0);
+                }
+            }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strcmp_mismatch);
+
+// Lookup of a key in a table of config keys sharing common prefixes.
+static bool bench_strcmp(void) {
+    static const char *const keys[] = {
+        "net.ipv4.route.max_size",  "net.ipv4.route.gc_timeout",
+        "net.ipv4.tcp.keepalive",   "net.ipv4.tcp.window_scaling",
+        "net.ipv6.route.max_size",  "kernel.sched.latency_ns",
+        "kernel.sched.min_gran_ns", "kernel.printk.devkmsg",
+    };
+    const size_t count = sizeof(keys) / sizeof(keys[0]);
+    char key[32];
+    int found = 0;
+
+    strzcpy(key, keys[count - 1], sizeof(key));
+    for (size_t i = 0; i < 1000; i++)
+        for (size_t k = 0; k < count; k++) {
+            if (!strcmp(keys[k], key)) found++;
+            if (!strncmp(keys[k], key, 12)) found++;
+        }
+    return found != 0;
+}
+DECLARE_BENCH(bench_strcmp);
+
+static bool test_strchr(void) {
+    static char buf[160];
+    const char *s = "key=value;key2=value2";
+
+    TEST_PTR_EQ(strchr(s, '='), s + 3);
+    TEST_PTR_EQ(strrchr(s, '='), s + 14);
+    TEST_PTR_EQ(strchr(s, 0), s + 21);
+    TEST_PTR_EQ(strrchr(s, 0), s + 21);
+    TEST_PTR_NULL(strchr(s, '#'));
+    TEST_PTR_NULL(strrchr(s, '#'));
+    TEST_PTR_NULL(strchr("", 'a'));
+
+    // Every start, length and match position, match value above 0x7f.
+    memset(buf, 'x', sizeof(buf));
+    for (size_t off = 0; off < 40; off++)
+        for (size_t len = 0; len < 100; len++) {
+            char *b = buf + off;
+            b[len] = 0;
+            // Matches outside of the string are ignored
+            b[len + 1] = (char)0xf0;
+            if (off) b[-1] = (char)0xf0;
+            TEST_PTR_NULL(strchr(b, 0xf0));
+            TEST_PTR_NULL(strrchr(b, 0xf0));
+            TEST_PTR_EQ(strchr(b, 0), b + len);
+            for (size_t pos = 0; pos < len; pos++) {
+                b[pos] = (char)0xf0;
+                TEST_PTR_EQ(strchr(b, 0xf0), b + pos);
+                TEST_PTR_EQ(strrchr(b, 0xf0), b + pos);
+                b[pos] = 'x';
+            }
+            if (len) {
+                b[0] = b[len - 1] = 'y';
+                TEST_PTR_EQ(strchr(b, 'y'), b);
+                TEST_PTR_EQ(strrchr(b, 'y'), b + len - 1);
+                b[0] = b[len - 1] = 'x';
+            }
+            memset(buf, 'x', sizeof(buf));
+        }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strchr);
+
+// Naive reference search
+static const char *ref_strstr(const char *h, const char *n) {
+    const size_t m = strlen(n);
+    for (;; h++) {
+        if (!strncmp(h, n, m)) return h;
+        if (!*h) return NULL;
+    }
+}
+
+static bool test_strstr(void) {
+    static char h[300];
+    char n[16];
+    const char *s = "GET /index.html HTTP/1.1";
+
+    TEST_PTR_EQ(strstr(s, ""), s);
+    TEST_PTR_EQ(strstr(s, "GET"), s);
+    TEST_PTR_EQ(strstr(s, "HTTP/"), s + 16);
+    TEST_PTR_EQ(strstr(s, "1.1"), s + 21);
+    TEST_PTR_EQ(strstr(s, "/"), s + 4);
+    TEST_PTR_NULL(strstr(s, "1.1 "));
+    TEST_PTR_NULL(strstr(s, "POST"));
+    TEST_PTR_NULL(strstr("", "a"));
+
+    // Needle across every position of a long haystack, which is scanned for
+    // its end in steps
+    memset(h, 'x', sizeof(h) - 1);
+    for (size_t pos = 0; pos + 8 < sizeof(h); pos++) {
+        memcpy(h + pos, "xyxyxyxz", 8);
+        TEST_PTR_EQ(strstr(h, "xyxyxyxz"), h + pos);
+        TEST_PTR_NULL(strstr(h, "xyxyxyxzx_"));
+        memset(h + pos, 'x', 8);
+    }
+
+    // Small alphabets make partial and periodic matches frequent
+    for (size_t i = 0; i < 20000; i++) {
+        const size_t hl = (size_t)rand() % (sizeof(h) - 1);
+        const size_t m = 1 + (size_t)rand() % (sizeof(n) - 1);
+        const int alpha = 2 + rand() % 3;
+        for (size_t j = 0; j < hl; j++)
+            h[j] = (char)('a' + rand() % alpha);
+        h[hl] = 0;
+        for (size_t j = 0; j < m; j++) n[j] = (char)('a' + rand() % alpha);
+        n[m] = 0;
+        // Plant the needle half of the time
+        if (hl >= m && (i & 1))
+            memcpy(h + (size_t)rand() % (hl - m + 1), n, m);
+        TEST_PTR_EQ(strstr(h, n), ref_strstr(h, n));
+    }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strstr);
+
+// Worst case for naive search, Two-Way keeps it linear.
+static bool test_strstr_periodic(void) {
+    static char h[16384];
+    static char n[1000];
+
+    memset(h, 'a', sizeof(h) - 1);
+    memset(n, 'a', sizeof(n) - 1);
+    n[sizeof(n) - 2] = 'b';
+    TEST_PTR_NULL(strstr(h, n));
+    h[sizeof(h) - 2] = 'b';
+    TEST_PTR_EQ(strstr(h, n), h + sizeof(h) - sizeof(n));
+    n[sizeof(n) - 2] = 'a';
+    n[0] = 'b';
+    TEST_PTR_NULL(strstr(h, n));
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strstr_periodic);
+
+// Match lines of a log against a few patterns.
+static bool bench_strstr(void) {
+    static const char *const lines[] = {
+        "[    0.000000] Linux version 6.1.0 (gcc 12.2.0) #1 SMP PREEMPT",
+        "[    0.412345] pci 0000:00:1f.2: reg 0x24 [mem 0xfebf1000-0xfebf1fff]",
+        "[    1.023456] usb 1-1: new high-speed USB device number 2 using ehci",
+        "[    2.345678] EXT4-fs (sda1): mounted filesystem with ordered data",
+        "[    3.456789] e1000e 0000:00:19.0 eth0: NIC Link is Up 1000 Mbps",
+    };
+    static const char *const patterns[] = {"error", "Link is Up", "mounted",
+                                           "0x"};
+    int found = 0;
+
+    for (size_t i = 0; i < 1000; i++)
+        for (size_t l = 0; l < sizeof(lines) / sizeof(lines[0]); l++)
+            for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++)
+                if (strstr(lines[l], patterns[p])) found++;
+    return found != 0;
+}
+DECLARE_BENCH(bench_strstr);
+
+static bool test_memchr3(void) {
+    static uint8_t buf[300];
+    const char *s = "GET / HTTP/1.1\r\nHost: a,b\r\n";
+
+    TEST_PTR_EQ(memchr2(s, '\n', '\r', 28), s + 14);
+    TEST_PTR_EQ(memchr3(s, ',', ':', '/', 28), s + 4);
+    TEST_PTR_EQ(memchr3(s + 17, ',', ':', '\n', 11), s + 20);
+    TEST_PTR_NULL(memchr2(s, '#', '!', 28));
+    TEST_PTR_NULL(memchr3(s, '\r', '\n', ',', 0));
+    TEST_PTR_NULL(memchr3(s, '\r', '\n', ',', 14));
+
+    // Every start, length and match position, match values above 0x7f.
+    memset(buf, 0x11, sizeof(buf));
+    for (size_t off = 0; off < 40; off++)
+        for (size_t len = 0; len < 100; len++) {
+            const uint8_t *b = buf + off;
+            // Matches just outside of the buffer are ignored
+            buf[off + len] = 0xf0;
+            if (off) buf[off - 1] = 0xf1;
+            TEST_PTR_NULL(memchr2(b, 0xf0, 0xf1, len));
+            TEST_PTR_NULL(memchr3(b, 0xf2, 0xf0, 0xf1, len));
+            for (size_t pos = 0; pos < len; pos++) {
+                buf[off + pos] = 0xf1;
+                if (pos + 1 < len) buf[off + len - 1] = 0xf2;
+                TEST_PTR_EQ(memchr2(b, 0xf0, 0xf1, len), b + pos);
+                TEST_PTR_EQ(memchr3(b, 0xf2, 0xf0, 0xf1, len), b + pos);
+                TEST_PTR_EQ(memchr3(b, 0xf2, 0xf0, 0xf1, pos + 1), b + pos);
+                buf[off + pos] = buf[off + len - 1] = 0x11;
+            }
+            buf[off + len] = 0x11;
+            if (off) buf[off - 1] = 0x11;
+        }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_memchr3);
+
+static bool test_memmem(void) {
+    static const uint8_t bin[] = {0, 1, 0, 0, 1, 0, 0, 0, 1, 0xff, 0};
+    static const uint8_t n1[] = {0, 0, 0, 1};
+    static const uint8_t n2[] = {0, 0, 0, 0};
+    const char *s = "--boundary\r\n\r\nbody\r\n--boundary--";
+
+    TEST_PTR_EQ(memmem(s, 32, "\r\n\r\n", 4), s + 10);
+    TEST_PTR_EQ(memmem(s, 32, "--boundary--", 12), s + 20);
+    TEST_PTR_NULL(memmem(s, 31, "--boundary--", 12));
+    TEST_PTR_EQ(memmem(s, 32, "", 0), s);
+    TEST_PTR_EQ(memmem(s, 32, "b", 1), s + 2);
+    TEST_PTR_NULL(memmem(s, 0, "b", 1));
+    // Null bytes are not special
+    TEST_PTR_EQ(memmem(bin, sizeof(bin), n1, sizeof(n1)), bin + 5);
+    TEST_PTR_NULL(memmem(bin, sizeof(bin), n2, sizeof(n2)));
+    TEST_PTR_EQ(memmem(bin, sizeof(bin), n1 + 2, 2), bin);
+    TEST_PTR_EQ(memmem(bin + 1, 10, n1 + 2, 2), bin + 3);
+    return is_test_succeed();
+}
+DECLARE_TEST(test_memmem);
+
+// Find the first of 3 delimiters in a CSV-like line, one pass with memchr3()
+// against a memchr() pass per delimiter.
+static bool bench_memchr3(void) {
+    static char line[1024];
+    const void *res = NULL;
+
+    memset(line, 'x', sizeof(line));
+    for (size_t len = 16; len <= sizeof(line); len *= 4) {
+        line[len - 1] = '\n';
+        uint64_t time = get_clock();
+        for (size_t i = 0; i < 1000; i++)
+            res = memchr3(line, ',', '\r', '\n', len);
+        uint64_t time3 = get_clock() - time;
+
+        time = get_clock();
+        for (size_t i = 0; i < 1000; i++) {
+            size_t n = len;
+            const char *p = memchr(line, ',', n);
+            if (p) n = (size_t)(p - line);
+            const char *q = memchr(line, '\r', n);
+            if (q) n = (size_t)((p = q) - line);
+            q = memchr(line, '\n', n);
+            res = q ? q : p;
+        }
+        time = get_clock() - time;
+        printf("delimiter at %4zu: memchr3 %6lu ns, 3x memchr %6lu ns\n", len,
+               time3, time);
+        line[len - 1] = 'x';
+    }
+    return res != NULL;
+}
+DECLARE_BENCH(bench_memchr3);
+
+// Naive reference for strspn() and strcspn()
+static size_t ref_span(const char *s, const char *set, bool accept) {
+    size_t i = 0;
+    while (s[i] && (strchr(set, s[i]) != NULL) == accept) i++;
+    return i;
+}
+
+static bool test_strspn(void) {
+    static char buf[200];
+    // Sets with few and many distinct high nibbles
+    static const char *const sets[] = {
+        "", "x", " \t", "0123456789", "abcdefABCDEF0123456789",
+        "\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9a", "\xf0\x80 ,;",
+    };
+    const char *s = "  key = value, other;";
+
+    TEST_EQ(strspn(s, " "), 2);
+    TEST_EQ(strspn(s, " yek"), 6);
+    TEST_EQ(strspn(s, ""), 0);
+    TEST_EQ(strcspn(s, "=,"), 6);
+    TEST_EQ(strcspn(s, "#"), 21);
+    TEST_EQ(strcspn(s, ""), 21);
+    TEST_PTR_EQ(strpbrk(s, ",;"), s + 13);
+    TEST_PTR_NULL(strpbrk(s, "#!"));
+    TEST_PTR_NULL(strpbrk("", " "));
+
+    for (size_t i = 0; i < 2000; i++) {
+        const char *set = sets[(size_t)rand() % (sizeof(sets) / sizeof(*sets))];
+        const size_t set_len = strlen(set);
+        const size_t off = (size_t)rand() % 40;
+        const size_t len = (size_t)rand() % (sizeof(buf) - off - 1);
+        char *b = buf + off;
+        // Mostly characters from the set to get long segments
+        for (size_t j = 0; j < len; j++)
+            b[j] = (set_len && rand() % 16)
+                       ? set[(size_t)rand() % set_len]
+                       : (char)(1 + rand() % 255);
+        b[len] = 0;
+        TEST_EQ(strspn(b, set), ref_span(b, set, true));
+        TEST_EQ(strcspn(b, set), ref_span(b, set, false));
+    }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strspn);
+
+// Split a config line into tokens.
+static bool bench_strspn(void) {
+    const char *line =
+        "option   ipv6_enabled  =  true ,  timeout = 30, retries=5, "
+        "server_address = 192.168.100.200, log_level = debug";
+    size_t tokens = 0;
+
+    for (size_t i = 0; i < 1000; i++)
+        for (const char *p = line + strspn(line, " \t,="); *p;) {
+            p += strcspn(p, " \t,=");
+            p += strspn(p, " \t,=");
+            tokens++;
+        }
+    return tokens != 0;
+}
+DECLARE_BENCH(bench_strspn);
+
+static bool test_strcpy(void) {
+    static char src[160], dst[200], ref[200];
+    char buf[16];
+
+    TEST_PTR_EQ(strcpy(buf, "abc"), buf);
+    TEST_STR_EQ(buf, "abc");
+    TEST_PTR_EQ(stpcpy(buf, "hello"), buf + 5);
+    TEST_PTR_EQ(stpcpy(stpcpy(buf + 5, ", "), "world"), buf + 12);
+    TEST_STR_EQ(buf, "hello, world");
+    TEST_PTR_EQ(strcat(buf, "!"), buf);
+    TEST_STR_EQ(buf, "hello, world!");
+    buf[5] = 0;
+    TEST_PTR_EQ(strncat(buf, " there!", 6), buf);
+    TEST_STR_EQ(buf, "hello there");
+    memset(buf, 'x', sizeof(buf));
+    TEST_PTR_EQ(strncpy(buf, "abc", 6), buf);
+    TEST_MEMCMP(buf, "abc\0\0\0x", 7);
+    TEST_PTR_EQ(strncpy(buf, "abcdef", 3), buf);
+    TEST_MEMCMP(buf, "abc\0\0\0x", 7);
+    TEST_STR_EQ(strzcpy(buf, "abcdef", 4), "abc");
+    TEST_PTR_EQ(mempcpy(buf, "abc", 3), buf + 3);
+    TEST_PTR_EQ(memccpy(buf, "key=value", '=', 16), buf + 4);
+    TEST_PTR_NULL(memccpy(buf, "key=value", '=', 3));
+
+    // Every alignment and length, destination bytes around are kept
+    for (size_t os = 0; os < 40; os++)
+        for (size_t od = 0; od < 9; od++)
+            for (size_t len = 0; len < 100; len++) {
+                char *s = src + os;
+                for (size_t i = 0; i < len; i++) s[i] = (char)(0x80 + i);
+                s[len] = 0;
+                memset(dst, 'x', sizeof(dst));
+                memset(ref, 'x', sizeof(ref));
+                memcpy(ref + od, s, len + 1);
+                TEST_PTR_EQ(stpcpy(dst + od, s), dst + od + len);
+                TEST_MEMCMP(dst, ref, sizeof(ref));
+
+                // Truncated copy
+                const size_t n = len / 2;
+                memset(dst, 'x', sizeof(dst));
+                TEST_PTR_EQ(strzcpy(dst + od, s, n + 1), dst + od);
+                TEST_EQ(strlen(dst + od), n);
+                TEST_EQ(dst[od + n + 1], 'x');
+                TEST_PTR_EQ(strncpy(dst + od, s, len + 8), dst + od);
+                TEST_MEMCMP(dst + od, ref + od, len);
+                TEST_MEMCHK(dst + od + len, 0, 8);
+                TEST_EQ(dst[od + len + 8], 'x');
+
+                // memccpy() stops after the byte, not at the null character
+                memset(dst, 'x', sizeof(dst));
+                TEST_PTR_NULL(memccpy(dst + od, s, 'x', len + 1));
+                TEST_MEMCMP(dst, ref, sizeof(ref));
+                if (!len) continue;
+                memset(dst, 'x', sizeof(dst));
+                TEST_PTR_EQ(memccpy(dst + od, s, s[len - 1], len + 8),
+                            dst + od + len);
+                TEST_MEMCMP(dst + od, s, len);
+                TEST_EQ(dst[od + len], 'x');
+            }
+    return is_test_succeed();
+}
+DECLARE_TEST(test_strcpy);
+
+// Build a path from components, appending with strcat() against stpcpy().
+static bool bench_stpcpy(void) {
+    static const char *const parts[] = {"/usr", "/local", "/share",
+                                        "/noc",  "/test", "/data.bin"};
+    char path[256];
+    size_t len = 0;
+
+    uint64_t time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        path[0] = 0;
+        for (size_t p = 0; p < sizeof(parts) / sizeof(parts[0]); p++)
+            strcat(path, parts[p]);
+        len += strlen(path);
+    }
+    uint64_t time_cat = get_clock() - time;
+
+    time = get_clock();
+    for (size_t i = 0; i < 1000; i++) {
+        char *end = path;
+        for (size_t p = 0; p < sizeof(parts) / sizeof(parts[0]); p++)
+            end = stpcpy(end, parts[p]);
+        len += (size_t)(end - path);
+    }
+    time = get_clock() - time;
+    printf("path building: strcat %lu ns, stpcpy %lu ns\n", time_cat, time);
+    return len != 0;
+}
+DECLARE_BENCH(bench_stpcpy);